@@ -3,23 +3,39 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <charconv>
+#include <chrono>
 #include <concepts>
 #include <exception>
 #include <functional>
 #include <initializer_list>
+#include <iosfwd>
 #include <limits>
 #include <locale>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
 #include <variant>
 #include <vector>
 
 #include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
 
 #define YK_JSON20_WIDEN_STRING(charT, strLiteral) \
   ::yk::json20::detail::select_str<charT, strLiteral, L##strLiteral, u8##strLiteral, u##strLiteral, U##strLiteral>::value
@@ -81,8 +97,406 @@ struct select_str<char32_t, Str, WStr, U8Str, U16Str, U32Str> {
   static constexpr auto value = U32Str;
 };
 
+template<class charT>
+inline constexpr bool is_utf8_v = std::is_same_v<charT, char> || std::is_same_v<charT, char8_t>;
+
+template<class charT>
+inline constexpr bool is_utf16_v = std::is_same_v<charT, char16_t> || (std::is_same_v<charT, wchar_t> && sizeof(wchar_t) == 2);
+
+template<class charT>
+inline constexpr bool is_utf32_v = std::is_same_v<charT, char32_t> || (std::is_same_v<charT, wchar_t> && sizeof(wchar_t) == 4);
+
+template<class charT>
+constexpr char32_t to_code_unit(charT c) noexcept
+{
+  return static_cast<char32_t>(static_cast<std::make_unsigned_t<charT>>(c));
+}
+
+template<class charT>
+constexpr void append_code_point(std::basic_string<charT>& out, char32_t cp)
+{
+  if constexpr (is_utf8_v<charT>) {
+    if (cp < 0x80) {
+      out.push_back(static_cast<charT>(cp));
+    } else if (cp < 0x800) {
+      out.push_back(static_cast<charT>(0xC0 | (cp >> 6)));
+      out.push_back(static_cast<charT>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+      out.push_back(static_cast<charT>(0xE0 | (cp >> 12)));
+      out.push_back(static_cast<charT>(0x80 | ((cp >> 6) & 0x3F)));
+      out.push_back(static_cast<charT>(0x80 | (cp & 0x3F)));
+    } else {
+      out.push_back(static_cast<charT>(0xF0 | (cp >> 18)));
+      out.push_back(static_cast<charT>(0x80 | ((cp >> 12) & 0x3F)));
+      out.push_back(static_cast<charT>(0x80 | ((cp >> 6) & 0x3F)));
+      out.push_back(static_cast<charT>(0x80 | (cp & 0x3F)));
+    }
+  } else if constexpr (is_utf16_v<charT>) {
+    if (cp < 0x10000) {
+      out.push_back(static_cast<charT>(cp));
+    } else {
+      cp -= 0x10000;
+      out.push_back(static_cast<charT>(0xD800 | (cp >> 10)));
+      out.push_back(static_cast<charT>(0xDC00 | (cp & 0x3FF)));
+    }
+  } else {
+    out.push_back(static_cast<charT>(cp));
+  }
+}
+
+// scalar UTF-8 validation of a single multi-byte sequence starting at `i`; returns the sequence length, or 0 if ill-formed (Unicode Table 3-7)
+template<class charT>
+constexpr std::size_t utf8_sequence_length(charT const* p, std::size_t i, std::size_t n) noexcept
+{
+  auto const at = [&](std::size_t k) { return to_code_unit(p[i + k]); };
+  auto const in = [](char32_t c, char32_t lo, char32_t hi) { return lo <= c && c <= hi; };
+
+  char32_t const c = at(0);
+  if (c < 0x80) return 1;
+  if (in(c, 0xC2, 0xDF)) return i + 2 <= n && in(at(1), 0x80, 0xBF) ? 2 : 0;
+  if (in(c, 0xE0, 0xEF)) {
+    if (i + 3 > n) return 0;
+    char32_t const lo = c == 0xE0 ? 0xA0 : 0x80;
+    char32_t const hi = c == 0xED ? 0x9F : 0xBF;
+    return in(at(1), lo, hi) && in(at(2), 0x80, 0xBF) ? 3 : 0;
+  }
+  if (in(c, 0xF0, 0xF4)) {
+    if (i + 4 > n) return 0;
+    char32_t const lo = c == 0xF0 ? 0x90 : 0x80;
+    char32_t const hi = c == 0xF4 ? 0x8F : 0xBF;
+    return in(at(1), lo, hi) && in(at(2), 0x80, 0xBF) && in(at(3), 0x80, 0xBF) ? 4 : 0;
+  }
+  return 0;
+}
+
+// returns the number of leading code units that are guaranteed to be ASCII
+template<class charT>
+inline std::size_t ascii_prefix_length(charT const* p, std::size_t n) noexcept
+{
+  static_assert(sizeof(charT) == 1);
+  std::size_t i = 0;
+#if defined(__SSE2__)
+  for (; i + 16 <= n; i += 16) {
+    __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+    if (_mm_movemask_epi8(block) != 0) return i;
+  }
+#endif
+  for (; i + 8 <= n; i += 8) {
+    std::uint64_t word;
+    std::memcpy(&word, p + i, 8);
+    if ((word & 0x8080808080808080ull) != 0) return i;
+  }
+  return i;
+}
+
+#if defined(__SSSE3__)
+// vectorized UTF-8 validation using the lookup algorithm described in
+// J. Keiser, D. Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte" (2021)
+class utf8_validator_ssse3 {
+public:
+  void feed(__m128i input) noexcept
+  {
+    if (_mm_movemask_epi8(input) == 0) {
+      error_ = _mm_or_si128(error_, prev_incomplete_);
+      prev_incomplete_ = _mm_setzero_si128();
+    } else {
+      __m128i const prev1 = _mm_alignr_epi8(input, prev_input_, 15);
+      __m128i const sc = special_cases(input, prev1);
+      error_ = _mm_or_si128(error_, multibyte_lengths(input, sc));
+      prev_incomplete_ = incomplete(input);
+    }
+    prev_input_ = input;
+  }
+
+  bool finish() noexcept
+  {
+    error_ = _mm_or_si128(error_, prev_incomplete_);
+    return all_zero(error_);
+  }
+
+private:
+  static bool all_zero(__m128i v) noexcept { return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) == 0xFFFF; }
+
+  static __m128i high_nibbles(__m128i v) noexcept { return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F)); }
+
+  static __m128i special_cases(__m128i input, __m128i prev1) noexcept
+  {
+    constexpr char too_short = 1 << 0;
+    constexpr char too_long = 1 << 1;
+    constexpr char overlong_3 = 1 << 2;
+    constexpr char too_large = 1 << 3;
+    constexpr char surrogate = 1 << 4;
+    constexpr char overlong_2 = 1 << 5;
+    constexpr char too_large_1000 = 1 << 6;
+    constexpr char overlong_4 = 1 << 6;
+    constexpr char two_conts = static_cast<char>(1 << 7);
+    constexpr char carry = too_short | too_long | two_conts;
+
+    __m128i const byte_1_high = _mm_shuffle_epi8(
+        _mm_setr_epi8(
+            too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,  //
+            two_conts, two_conts, two_conts, two_conts,                                      //
+            too_short | overlong_2,                                                          //
+            too_short,                                                                       //
+            too_short | overlong_3 | surrogate,                                              //
+            too_short | too_large | too_large_1000 | overlong_4                              //
+        ),
+        high_nibbles(prev1)
+    );
+    __m128i const byte_1_low = _mm_shuffle_epi8(
+        _mm_setr_epi8(
+            carry | overlong_3 | overlong_2 | overlong_4,             //
+            carry | overlong_2,                                       //
+            carry, carry,                                             //
+            carry | too_large,                                        //
+            carry | too_large | too_large_1000,                       //
+            carry | too_large | too_large_1000,                       //
+            carry | too_large | too_large_1000,                       //
+            carry | too_large | too_large_1000,                       //
+            carry | too_large | too_large_1000,                       //
+            carry | too_large | too_large_1000,                       //
+            carry | too_large | too_large_1000,                       //
+            carry | too_large | too_large_1000,                       //
+            carry | too_large | too_large_1000 | surrogate,           //
+            carry | too_large | too_large_1000,                       //
+            carry | too_large | too_large_1000                        //
+        ),
+        _mm_and_si128(prev1, _mm_set1_epi8(0x0F))
+    );
+    __m128i const byte_2_high = _mm_shuffle_epi8(
+        _mm_setr_epi8(
+            too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,  //
+            too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,            //
+            too_long | overlong_2 | two_conts | overlong_3 | too_large,                              //
+            too_long | overlong_2 | two_conts | surrogate | too_large,                               //
+            too_long | overlong_2 | two_conts | surrogate | too_large,                               //
+            too_short, too_short, too_short, too_short                                               //
+        ),
+        high_nibbles(input)
+    );
+    return _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+  }
+
+  __m128i multibyte_lengths(__m128i input, __m128i sc) const noexcept
+  {
+    __m128i const prev2 = _mm_alignr_epi8(input, prev_input_, 14);
+    __m128i const prev3 = _mm_alignr_epi8(input, prev_input_, 13);
+    __m128i const is_third_byte = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m128i const is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m128i const must23_80 = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(static_cast<char>(0x80)));
+    return _mm_xor_si128(must23_80, sc);
+  }
+
+  static __m128i incomplete(__m128i input) noexcept
+  {
+    __m128i const max_value = _mm_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,                                                  //
+        static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1)               //
+    );
+    return _mm_subs_epu8(input, max_value);
+  }
+
+  __m128i error_ = _mm_setzero_si128();
+  __m128i prev_input_ = _mm_setzero_si128();
+  __m128i prev_incomplete_ = _mm_setzero_si128();
+};
+#endif
+
+template<class charT>
+constexpr bool validate_utf8(charT const* p, std::size_t n) noexcept
+{
+  static_assert(sizeof(charT) == 1);
+  std::size_t i = 0;
+  if (!std::is_constant_evaluated()) {
+    i = ascii_prefix_length(p, n);
+    if (i == n) return true;
+#if defined(__SSSE3__)
+    utf8_validator_ssse3 validator;
+    for (; i + 16 <= n; i += 16) {
+      validator.feed(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i)));
+    }
+    if (i < n) {
+      unsigned char tail[16]{};
+      std::memcpy(tail, p + i, n - i);
+      validator.feed(_mm_loadu_si128(reinterpret_cast<__m128i const*>(tail)));
+    }
+    return validator.finish();
+#endif
+  }
+  while (i < n) {
+    std::size_t const len = utf8_sequence_length(p, i, n);
+    if (len == 0) return false;
+    i += len;
+    if (len == 1 && !std::is_constant_evaluated()) i += ascii_prefix_length(p + i, n - i);
+  }
+  return true;
+}
+
+template<class charT>
+constexpr bool validate_utf16(charT const* p, std::size_t n) noexcept
+{
+  for (std::size_t i = 0; i < n; ++i) {
+    char32_t const c = to_code_unit(p[i]);
+    if (c < 0xD800 || c > 0xDFFF) continue;
+    if (c > 0xDBFF || i + 1 == n) return false;
+    char32_t const next = to_code_unit(p[i + 1]);
+    if (next < 0xDC00 || next > 0xDFFF) return false;
+    ++i;
+  }
+  return true;
+}
+
+template<class charT>
+constexpr bool validate_utf32(charT const* p, std::size_t n) noexcept
+{
+  for (std::size_t i = 0; i < n; ++i) {
+    char32_t const c = to_code_unit(p[i]);
+    if (c > 0x10FFFF || (0xD800 <= c && c <= 0xDFFF)) return false;
+  }
+  return true;
+}
+
+// validates the code unit sequence according to the Unicode encoding form implied by charT
+template<class charT>
+constexpr bool validate_encoding(std::basic_string_view<charT> str) noexcept
+{
+  if constexpr (is_utf8_v<charT>) {
+    return validate_utf8(str.data(), str.size());
+  } else if constexpr (is_utf16_v<charT>) {
+    return validate_utf16(str.data(), str.size());
+  } else {
+    return validate_utf32(str.data(), str.size());
+  }
+}
+
+// returns the offset of the first code unit in `str` at or after `pos` that is a quotation mark, a reverse solidus or a control character
+template<class charT>
+constexpr std::size_t find_string_special(std::basic_string_view<charT> str, std::size_t pos) noexcept
+{
+  std::size_t i = pos;
+  std::size_t const n = str.size();
+#if defined(__SSE2__)
+  if constexpr (sizeof(charT) == 1) {
+    if (!std::is_constant_evaluated()) {
+      __m128i const quote = _mm_set1_epi8('"');
+      __m128i const backslash = _mm_set1_epi8('\\');
+      __m128i const control_max = _mm_set1_epi8(0x1F);
+      for (; i + 16 <= n; i += 16) {
+        __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str.data() + i));
+        __m128i const is_quote = _mm_cmpeq_epi8(block, quote);
+        __m128i const is_backslash = _mm_cmpeq_epi8(block, backslash);
+        __m128i const is_control = _mm_cmpeq_epi8(_mm_min_epu8(block, control_max), block);
+        int const mask = _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(is_quote, is_backslash), is_control));
+        if (mask != 0) return i + std::countr_zero(static_cast<unsigned>(mask));
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    char32_t const c = to_code_unit(str[i]);
+    if (c == U'"' || c == U'\\' || c < 0x20) return i;
+  }
+  return n;
+}
+
+template<class charT>
+constexpr int hex_digit_value(charT c) noexcept
+{
+  char32_t const u = to_code_unit(c);
+  if (U'0' <= u && u <= U'9') return static_cast<int>(u - U'0');
+  if (U'a' <= u && u <= U'f') return static_cast<int>(u - U'a' + 10);
+  if (U'A' <= u && u <= U'F') return static_cast<int>(u - U'A' + 10);
+  return -1;
+}
+
+// numbers consist of ASCII characters only, so narrowing them code unit by code unit is lossless;
+// anything else is mapped to NUL, which no number parser accepts
+template<class charT>
+constexpr std::string narrow_ascii(std::basic_string_view<charT> str)
+{
+  std::string narrow(str.size(), '\0');
+  std::ranges::transform(str, narrow.begin(), [](charT c) {
+    auto const u = to_code_unit(c);
+    return u < 0x80 ? static_cast<char>(u) : '\0';
+  });
+  return narrow;
+}
+
+template<class charT>
+inline constexpr int encoding_form_v = is_utf8_v<charT> ? 8 : is_utf16_v<charT> ? 16 : 32;
+
+struct decoded_code_point {
+  char32_t value;
+  std::size_t length;
+};
+
+// decodes the code point starting at `i`; the input is expected to be well-formed, ill-formed sequences decode to U+FFFD
+template<class charT>
+constexpr decoded_code_point decode_code_point(std::basic_string_view<charT> str, std::size_t i) noexcept
+{
+  char32_t const c = to_code_unit(str[i]);
+  if constexpr (is_utf8_v<charT>) {
+    std::size_t const len = utf8_sequence_length(str.data(), i, str.size());
+    switch (len) {
+      case 1: return {c, 1};
+      case 2: return {((c & 0x1F) << 6) | (to_code_unit(str[i + 1]) & 0x3F), 2};
+      case 3: return {((c & 0x0F) << 12) | ((to_code_unit(str[i + 1]) & 0x3F) << 6) | (to_code_unit(str[i + 2]) & 0x3F), 3};
+      case 4:
+        return {
+            ((c & 0x07) << 18) | ((to_code_unit(str[i + 1]) & 0x3F) << 12) | ((to_code_unit(str[i + 2]) & 0x3F) << 6) | (to_code_unit(str[i + 3]) & 0x3F), 4
+        };
+      default: return {0xFFFD, 1};
+    }
+  } else if constexpr (is_utf16_v<charT>) {
+    if (c < 0xD800 || c > 0xDFFF) return {c, 1};
+    if (c <= 0xDBFF && i + 1 < str.size()) {
+      char32_t const next = to_code_unit(str[i + 1]);
+      if (0xDC00 <= next && next <= 0xDFFF) return {0x10000 + ((c - 0xD800) << 10) + (next - 0xDC00), 2};
+    }
+    return {0xFFFD, 1};
+  } else {
+    return {c, 1};
+  }
+}
+
+// appends `in` to `out`, converting between the Unicode encoding forms of fromCharT and toCharT
+template<class toCharT, class fromCharT>
+constexpr void transcode_append(std::basic_string<toCharT>& out, std::basic_string_view<fromCharT> in)
+{
+  if constexpr (encoding_form_v<toCharT> == encoding_form_v<fromCharT>) {
+    out.append(in.begin(), in.end());
+  } else {
+    out.reserve(out.size() + in.size());
+    std::size_t i = 0;
+    while (i < in.size()) {
+      // ASCII runs are identical in every encoding form and are widened or narrowed in bulk
+      std::size_t j = i;
+      while (j < in.size() && to_code_unit(in[j]) < 0x80) ++j;
+      out.append(in.begin() + i, in.begin() + j);
+      if (j == in.size()) break;
+      auto const [cp, len] = decode_code_point(in, j);
+      append_code_point(out, cp);
+      i = j + len;
+    }
+  }
+}
+
+template<class toCharT, class fromCharT>
+constexpr std::basic_string<toCharT> transcode(std::basic_string_view<fromCharT> in)
+{
+  std::basic_string<toCharT> out;
+  transcode_append(out, in);
+  return out;
+}
+
 }  // namespace detail
 
+template<class charT>
+constexpr bool is_valid_unicode(std::basic_string_view<charT> str) noexcept
+{
+  return detail::validate_encoding(str);
+}
+
 template<class charT, class Tuple>
 struct deserialize_result {
   typename std::basic_string_view<charT>::iterator it;
@@ -100,27 +514,34 @@ struct deserializer {
   static constexpr auto deserialize(std::basic_string_view<charT> str) = delete;
 };
 
-template<>
-struct deserializer<bool, char> {
-  static constexpr std::string_view true_ = "true";
-  static constexpr std::string_view false_ = "false";
-  static constexpr auto deserialize(std::string_view str)
+template<class charT>
+struct deserializer<bool, charT> {
+  static constexpr std::basic_string_view<charT> true_ = YK_JSON20_WIDEN_STRING(charT, "true");
+  static constexpr std::basic_string_view<charT> false_ = YK_JSON20_WIDEN_STRING(charT, "false");
+  static constexpr auto deserialize(std::basic_string_view<charT> str)
   {
-    if (str == true_) return make_deserialize_result<char>(str.begin() + true_.size(), true);
-    if (str == false_) return make_deserialize_result<char>(str.begin() + false_.size(), false);
+    if (str == true_) return make_deserialize_result<charT>(str.begin() + true_.size(), true);
+    if (str == false_) return make_deserialize_result<charT>(str.begin() + false_.size(), false);
     throw std::invalid_argument("argument is not boolean");
   }
 };
 
-template<class T>
+template<class T, class charT>
   requires std::integral<T> || std::floating_point<T>
-struct deserializer<T, char> {
-  static constexpr auto deserialize(std::string_view str)
+struct deserializer<T, charT> {
+  static constexpr auto deserialize(std::basic_string_view<charT> str)
   {
     T value{};
-    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
-    if (ec != std::errc{}) throw std::invalid_argument("from_chars error");
-    return make_deserialize_result<char>(str.begin() + (ptr - str.data()), std::move(value));
+    if constexpr (std::is_same_v<charT, char>) {
+      auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+      if (ec != std::errc{}) throw std::invalid_argument("from_chars error");
+      return make_deserialize_result<charT>(str.begin() + (ptr - str.data()), std::move(value));
+    } else {
+      std::string const narrow = detail::narrow_ascii(str);
+      auto [ptr, ec] = std::from_chars(narrow.data(), narrow.data() + narrow.size(), value);
+      if (ec != std::errc{}) throw std::invalid_argument("from_chars error");
+      return make_deserialize_result<charT>(str.begin() + (ptr - narrow.data()), std::move(value));
+    }
   }
 };
 
@@ -129,22 +550,26 @@ struct serializer {
   static constexpr std::basic_string<charT> serialize(T const& x) = delete;
 };
 
-template<>
-struct serializer<bool, char> {
-  static constexpr std::string_view true_ = "true";
-  static constexpr std::string_view false_ = "false";
-  static constexpr std::string serialize(bool const& x) { return std::string(x ? true_ : false_); }
+template<class charT>
+struct serializer<bool, charT> {
+  static constexpr std::basic_string_view<charT> true_ = YK_JSON20_WIDEN_STRING(charT, "true");
+  static constexpr std::basic_string_view<charT> false_ = YK_JSON20_WIDEN_STRING(charT, "false");
+  static constexpr std::basic_string<charT> serialize(bool const& x) { return std::basic_string<charT>(x ? true_ : false_); }
 };
 
-template<class T>
+template<class T, class charT>
   requires std::integral<T> || std::floating_point<T>
-struct serializer<T, char> {
-  static constexpr std::string serialize(T const& x)
+struct serializer<T, charT> {
+  // the longest shortest-round-trip representation of a floating-point value is well below 64 characters;
+  // integers need their digits plus a sign
+  static constexpr std::size_t buffer_size = std::floating_point<T> ? 64 : std::numeric_limits<T>::digits10 + 3;
+
+  static constexpr std::basic_string<charT> serialize(T const& x)
   {
-    char buf[std::numeric_limits<T>::digits10 + 1];
+    char buf[buffer_size];
     auto [ptr, ec] = std::to_chars(std::begin(buf), std::end(buf), x);
     if (ec != std::errc{}) throw std::runtime_error("to_chars error");
-    return std::string(buf);
+    return std::basic_string<charT>(std::begin(buf), ptr);
   }
 };
 
@@ -159,8 +584,122 @@ enum class json_value_kind {
   object,
 };
 
+// returned by a visitor callback to steer the parser; callbacks returning void always proceed.
+// skip is honored by on_array_start, on_object_start and on_key, and is treated as proceed elsewhere
+enum class visit_action {
+  proceed,
+  skip,  // jump over the container (or the member value, for on_key) without reporting it
+  stop,  // end the parse successfully; the rest of the input is not examined
+};
+
 class bad_json_access : public std::exception {};
 
+class json_patch_error : public std::invalid_argument {
+public:
+  json_patch_error(char const* what, std::size_t operation_index) : std::invalid_argument(what), operation_index_(operation_index) {}
+
+  // index of the failing operation within the patch document
+  std::size_t operation_index() const noexcept { return operation_index_; }
+
+private:
+  std::size_t operation_index_;
+};
+
+// counters filled in by the parse/try_parse overloads taking a sink; values accumulate across calls
+struct parse_stats {
+  std::size_t bytes_consumed = 0;
+  std::array<std::size_t, 8> tokens{};  // indexed by json_value_kind; object keys count as strings
+  std::size_t max_depth = 0;
+
+  // allocations performed by basic_json_visitor, as observed through the capacities of the containers it grows
+  std::size_t allocations = 0;
+  std::size_t bytes_allocated = 0;
+
+  std::chrono::nanoseconds validate_time{};
+  std::chrono::nanoseconds parse_time{};
+  std::chrono::nanoseconds build_time{};
+
+  constexpr std::size_t token_count(json_value_kind kind) const noexcept { return tokens[static_cast<std::size_t>(kind)]; }
+};
+
+namespace detail {
+
+// adds the wall time of its lifetime to `target`; does nothing during constant evaluation
+class phase_timer {
+public:
+  constexpr explicit phase_timer(std::chrono::nanoseconds& target) noexcept : target_(target)
+  {
+    if (!std::is_constant_evaluated()) start_ = std::chrono::steady_clock::now();
+  }
+  constexpr ~phase_timer()
+  {
+    if (!std::is_constant_evaluated()) target_ += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+  }
+
+private:
+  std::chrono::nanoseconds& target_;
+  std::chrono::steady_clock::time_point start_{};
+};
+
+// numeric value of a JSON number independent of its spelling: integral values (including those written as
+// floating-point, e.g. 1.0 or 1e2) within 64-bit range are exact integers, everything else is a double
+struct canonical_number {
+  enum class form { integer, floating, text } form;
+  bool negative = false;
+  std::uint64_t magnitude = 0;
+  double value = 0;
+
+  constexpr bool operator==(canonical_number const&) const = default;
+};
+
+inline canonical_number canonicalize_number(std::string_view narrow)
+{
+  char const* const first = narrow.data();
+  char const* const last = first + narrow.size();
+  bool const negative = !narrow.empty() && narrow.front() == '-';
+
+  if (narrow.find_first_of(".eE") == std::string_view::npos) {
+    std::uint64_t magnitude = 0;
+    auto [ptr, ec] = std::from_chars(first + negative, last, magnitude);
+    if (ec == std::errc{} && ptr == last) return {canonical_number::form::integer, negative && magnitude != 0, magnitude, 0};
+  }
+
+  double value = 0;
+  auto [ptr, ec] = std::from_chars(first, last, value);
+  if (ec != std::errc{} || ptr != last) return {canonical_number::form::text};
+  double const abs = value < 0 ? -value : value;
+  if (abs < 18446744073709551616.0 && static_cast<double>(static_cast<std::uint64_t>(abs)) == abs) {
+    auto const magnitude = static_cast<std::uint64_t>(abs);
+    return {canonical_number::form::integer, value < 0 && magnitude != 0, magnitude, 0};
+  }
+  return {canonical_number::form::floating, false, 0, value};
+}
+
+template<class charT>
+constexpr canonical_number canonicalize_number(std::basic_string_view<charT> text)
+{
+  if constexpr (std::is_same_v<charT, char>) {
+    return canonicalize_number(std::string_view(text));
+  } else {
+    return canonicalize_number(std::string_view(narrow_ascii(text)));
+  }
+}
+
+constexpr std::uint64_t mix_hash(std::uint64_t x) noexcept
+{
+  // splitmix64 finalizer
+  x ^= x >> 30;
+  x *= 0xBF58476D1CE4E5B9ull;
+  x ^= x >> 27;
+  x *= 0x94D049BB133111EBull;
+  x ^= x >> 31;
+  return x;
+}
+
+constexpr std::uint64_t combine_hash(std::uint64_t seed, std::uint64_t value) noexcept { return mix_hash(seed + 0x9E3779B97F4A7C15ull + value); }
+
+}  // namespace detail
+
 template<class charT>
 class basic_json {
 private:
@@ -258,21 +797,21 @@ public:
   constexpr std::optional<T> try_as_unsigned_integer() const noexcept
   {
     if (get_kind() != json_value_kind::number_unsigned_integer) return std::nullopt;
-    return as_unsigned_integer_unchecked();
+    return as_unsigned_integer_unchecked<T>();
   }
 
   template<class T>
   constexpr std::optional<T> try_as_signed_integer() const noexcept
   {
     if (get_kind() != json_value_kind::number_signed_integer) return std::nullopt;
-    return as_signed_integer_unchecked();
+    return as_signed_integer_unchecked<T>();
   }
 
   template<class T>
   constexpr std::optional<T> try_as_floating_point() const noexcept
   {
     if (get_kind() != json_value_kind::number_floating_point) return std::nullopt;
-    return as_floating_point_unchecked();
+    return as_floating_point_unchecked<T>();
   }
 
   constexpr std::optional<std::basic_string<charT>> try_as_string() const noexcept
@@ -371,16 +910,123 @@ public:
     if (get_kind() != json_value_kind::object) throw bad_json_access{};
     auto& vec = std::get<2>(data_);
     auto iter = std::ranges::lower_bound(vec, key, {}, &std::pair<std::basic_string<charT>, basic_json>::first);
-    if (iter != vec.end() && iter->first == key) return;
+    if (iter == vec.end() || iter->first != key) return;
     vec.erase(iter);
   }
 
+  // applies an RFC 7396 merge patch in place; members of `patch` are moved into the document
+  constexpr void merge_patch(basic_json patch)
+  {
+    if (patch.kind_ != json_value_kind::object) {
+      *this = std::move(patch);
+      return;
+    }
+    if (kind_ != json_value_kind::object) {
+      kind_ = json_value_kind::object;
+      data_.template emplace<2>();
+    }
+
+    // both member vectors are sorted by key, so they are merged in a single linear pass
+    auto& target = std::get<2>(data_);
+    auto& source = std::get<2>(patch.data_);
+    std::vector<std::pair<std::basic_string<charT>, basic_json>> merged;
+    merged.reserve(target.size() + source.size());
+    auto t = target.begin();
+    auto p = source.begin();
+    while (t != target.end() || p != source.end()) {
+      if (p == source.end() || (t != target.end() && t->first < p->first)) {
+        merged.emplace_back(std::move(*t++));
+        continue;
+      }
+      bool const matched = t != target.end() && t->first == p->first;
+      if (p->second.kind_ == json_value_kind::null) {
+        if (matched) ++t;
+        ++p;
+        continue;
+      }
+      if (matched) {
+        t->second.merge_patch(std::move(p->second));
+        merged.emplace_back(std::move(*t++));
+      } else {
+        basic_json value(nullptr);
+        value.merge_patch(std::move(p->second));
+        merged.emplace_back(std::move(p->first), std::move(value));
+      }
+      ++p;
+    }
+    target = std::move(merged);
+  }
+
+  // applies an RFC 6902 JSON Patch in place; values are moved out of `patch`.
+  // if any operation fails the document is restored to its original state and json_patch_error is thrown
+  constexpr void apply_patch(basic_json patch)
+  {
+    if (auto failure = apply_patch_impl(std::move(patch))) throw json_patch_error(failure->message, failure->index);
+  }
+
+  constexpr bool try_apply_patch(basic_json patch) { return !apply_patch_impl(std::move(patch)); }
+
+  // structural equality: numbers compare by value regardless of kind and spelling (1, 1.0 and 1e0 are equal),
+  // objects compare as sets of members
+  friend constexpr bool operator==(basic_json const& lhs, basic_json const& rhs)
+  {
+    bool const lhs_number = is_number(lhs.kind_);
+    if (lhs_number != is_number(rhs.kind_)) return false;
+    if (lhs_number) {
+      auto const& lhs_text = std::get<0>(lhs.data_);
+      auto const& rhs_text = std::get<0>(rhs.data_);
+      if (lhs_text == rhs_text) return true;
+      auto const a = detail::canonicalize_number<charT>(lhs_text);
+      auto const b = detail::canonicalize_number<charT>(rhs_text);
+      return a.form != detail::canonical_number::form::text && a == b;
+    }
+    if (lhs.kind_ != rhs.kind_) return false;
+    switch (lhs.kind_) {
+      case json_value_kind::array: return std::ranges::equal(std::get<1>(lhs.data_), std::get<1>(rhs.data_));
+      case json_value_kind::object: return std::ranges::equal(std::get<2>(lhs.data_), std::get<2>(rhs.data_));
+      case json_value_kind::boolean: return lhs.as_boolean_unchecked() == rhs.as_boolean_unchecked();
+      case json_value_kind::null: return true;
+      default: return std::get<0>(lhs.data_) == std::get<0>(rhs.data_);
+    }
+  }
+
+  // consistent with operator==
+  std::size_t hash() const noexcept
+  {
+    std::uint64_t seed = static_cast<std::uint64_t>(is_number(kind_) ? json_value_kind::number_floating_point : kind_);
+    switch (kind_) {
+      case json_value_kind::null: break;
+      case json_value_kind::boolean: seed = detail::combine_hash(seed, as_boolean_unchecked()); break;
+      case json_value_kind::string: seed = detail::combine_hash(seed, std::hash<std::basic_string_view<charT>>{}(std::get<0>(data_))); break;
+      case json_value_kind::array:
+        for (auto const& element : std::get<1>(data_)) seed = detail::combine_hash(seed, element.hash());
+        break;
+      case json_value_kind::object:
+        for (auto const& [key, value] : std::get<2>(data_)) {
+          seed = detail::combine_hash(seed, std::hash<std::basic_string_view<charT>>{}(key));
+          seed = detail::combine_hash(seed, value.hash());
+        }
+        break;
+      default: {
+        auto const number = detail::canonicalize_number<charT>(std::get<0>(data_));
+        switch (number.form) {
+          case detail::canonical_number::form::integer: seed = detail::combine_hash(detail::combine_hash(seed, number.negative), number.magnitude); break;
+          case detail::canonical_number::form::floating: seed = detail::combine_hash(seed, std::bit_cast<std::uint64_t>(number.value)); break;
+          case detail::canonical_number::form::text: seed = detail::combine_hash(seed, std::hash<std::basic_string_view<charT>>{}(std::get<0>(data_))); break;
+        }
+      }
+    }
+    return static_cast<std::size_t>(detail::mix_hash(seed));
+  }
+
 public:
-  template<class charT2>
+  template<class charT2, class StatsT>
   friend class basic_json_visitor;
 
   constexpr basic_json() : kind_(json_value_kind::object), data_(std::in_place_index<2>) {}
 
+  constexpr basic_json(std::nullptr_t) : kind_(json_value_kind::null), data_(std::in_place_index<0>, YK_JSON20_WIDEN_STRING(charT, "null")) {}
+
   constexpr basic_json(bool x) : kind_(json_value_kind::boolean), data_(std::in_place_index<0>, serializer<bool, charT>::serialize(x)) {}
 
   template<std::unsigned_integral UInt>
@@ -412,6 +1058,13 @@ public:
     std::ranges::sort(std::get<2>(data_), {}, &std::pair<std::basic_string<charT>, basic_json>::first);
   }
 
+  constexpr basic_json& operator=(std::nullptr_t)
+  {
+    kind_ = json_value_kind::null;
+    data_.template emplace<0>(YK_JSON20_WIDEN_STRING(charT, "null"));
+    return *this;
+  }
+
   template<std::unsigned_integral UInt>
   constexpr basic_json& operator=(UInt x)
   {
@@ -465,106 +1118,794 @@ public:
   {
   }
 
-  static constexpr basic_json array(std::initializer_list<basic_json> il) { return basic_json(std::move(il)); }
+  static constexpr basic_json array(std::initializer_list<basic_json> il) { return basic_json(std::move(il)); }
+
+  static constexpr basic_json object(std::initializer_list<std::pair<std::basic_string<charT>, basic_json>> il) { return basic_json(std::move(il)); }
+
+private:
+  using member_type = std::pair<std::basic_string<charT>, basic_json>;
+  using pointer_type = std::vector<std::basic_string<charT>>;
+
+  struct patch_failure {
+    char const* message;
+    std::size_t index;
+  };
+
+  enum class patch_op { add, remove, replace, move };
+
+  // inverse of an applied operation, replayed in reverse order when a later operation fails
+  struct undo_entry {
+    patch_op op;
+    pointer_type path;
+    pointer_type from{};
+    basic_json value{};
+    bool replaced = false;  // for move: the move overwrote `value` at `path`
+  };
+
+  // splits an RFC 6901 JSON Pointer into unescaped reference tokens
+  static constexpr std::optional<pointer_type> parse_pointer(std::basic_string_view<charT> str)
+  {
+    pointer_type tokens;
+    if (str.empty()) return tokens;
+    if (detail::to_code_unit(str[0]) != U'/') return std::nullopt;
+    str.remove_prefix(1);
+    while (true) {
+      auto& token = tokens.emplace_back();
+      std::size_t i = 0;
+      for (; i < str.size() && detail::to_code_unit(str[i]) != U'/'; ++i) {
+        if (detail::to_code_unit(str[i]) != U'~') {
+          token.push_back(str[i]);
+          continue;
+        }
+        if (i + 1 == str.size()) return std::nullopt;
+        switch (detail::to_code_unit(str[++i])) {
+          case U'0': token.push_back(YK_JSON20_WIDEN_STRING(charT, "~").data[0]); break;
+          case U'1': token.push_back(YK_JSON20_WIDEN_STRING(charT, "/").data[0]); break;
+          default: return std::nullopt;
+        }
+      }
+      if (i == str.size()) break;
+      str.remove_prefix(i + 1);
+    }
+    return tokens;
+  }
+
+  // array indices are decimal without leading zeros; "-" refers to the position past the last element
+  static constexpr std::optional<std::size_t> parse_index(std::basic_string_view<charT> token, std::size_t size, bool allow_end) noexcept
+  {
+    if (allow_end && token == YK_JSON20_WIDEN_STRING(charT, "-")) return size;
+    if (token.empty() || (token.size() > 1 && detail::to_code_unit(token[0]) == U'0')) return std::nullopt;
+    std::size_t index = 0;
+    for (auto c : token) {
+      char32_t const u = detail::to_code_unit(c);
+      if (u < U'0' || u > U'9') return std::nullopt;
+      if (index > (std::numeric_limits<std::size_t>::max() - 9) / 10) return std::nullopt;
+      index = index * 10 + (u - U'0');
+    }
+    if (index > size || (index == size && !allow_end)) return std::nullopt;
+    return index;
+  }
+
+  constexpr typename std::vector<member_type>::iterator find_member(std::basic_string_view<charT> key)
+  {
+    auto& vec = std::get<2>(data_);
+    auto iter = std::ranges::lower_bound(vec, key, {}, &member_type::first);
+    if (iter != vec.end() && iter->first != key) return vec.end();
+    return iter;
+  }
+
+  constexpr basic_json* resolve(std::span<std::basic_string<charT> const> tokens)
+  {
+    basic_json* node = this;
+    for (auto const& token : tokens) {
+      if (node->kind_ == json_value_kind::object) {
+        auto& vec = std::get<2>(node->data_);
+        auto iter = node->find_member(token);
+        if (iter == vec.end()) return nullptr;
+        node = &iter->second;
+      } else if (node->kind_ == json_value_kind::array) {
+        auto& vec = std::get<1>(node->data_);
+        auto index = parse_index(token, vec.size(), false);
+        if (!index) return nullptr;
+        node = &vec[*index];
+      } else {
+        return nullptr;
+      }
+    }
+    return node;
+  }
+
+  // inserts `value` at `path` and returns the inverse operation; `value` is left untouched on failure
+  constexpr std::optional<undo_entry> add_at(pointer_type path, basic_json&& value)
+  {
+    if (path.empty()) {
+      undo_entry undo{patch_op::replace, {}, {}, std::move(*this)};
+      *this = std::move(value);
+      return undo;
+    }
+    basic_json* parent = resolve(std::span(path).first(path.size() - 1));
+    if (!parent) return std::nullopt;
+    auto& token = path.back();
+    if (parent->kind_ == json_value_kind::object) {
+      auto& vec = std::get<2>(parent->data_);
+      auto iter = std::ranges::lower_bound(vec, token, {}, &member_type::first);
+      if (iter != vec.end() && iter->first == token) {
+        undo_entry undo{patch_op::replace, std::move(path), {}, std::move(iter->second)};
+        iter->second = std::move(value);
+        return undo;
+      }
+      vec.emplace(iter, token, std::move(value));
+      return undo_entry{patch_op::remove, std::move(path)};
+    }
+    if (parent->kind_ == json_value_kind::array) {
+      auto& vec = std::get<1>(parent->data_);
+      auto index = parse_index(token, vec.size(), true);
+      if (!index) return std::nullopt;
+      vec.emplace(vec.begin() + *index, std::move(value));
+      token = serializer<std::size_t, charT>::serialize(*index);
+      return undo_entry{patch_op::remove, std::move(path)};
+    }
+    return std::nullopt;
+  }
+
+  constexpr std::optional<basic_json> remove_at(pointer_type const& path)
+  {
+    if (path.empty()) return std::nullopt;
+    basic_json* parent = resolve(std::span(path).first(path.size() - 1));
+    if (!parent) return std::nullopt;
+    auto const& token = path.back();
+    if (parent->kind_ == json_value_kind::object) {
+      auto& vec = std::get<2>(parent->data_);
+      auto iter = parent->find_member(token);
+      if (iter == vec.end()) return std::nullopt;
+      basic_json removed = std::move(iter->second);
+      vec.erase(iter);
+      return removed;
+    }
+    if (parent->kind_ == json_value_kind::array) {
+      auto& vec = std::get<1>(parent->data_);
+      auto index = parse_index(token, vec.size(), false);
+      if (!index) return std::nullopt;
+      basic_json removed = std::move(vec[*index]);
+      vec.erase(vec.begin() + *index);
+      return removed;
+    }
+    return std::nullopt;
+  }
+
+  // returns the replaced value
+  constexpr std::optional<basic_json> replace_at(pointer_type const& path, basic_json&& value)
+  {
+    basic_json* target = resolve(path);
+    if (!target) return std::nullopt;
+    basic_json old = std::move(*target);
+    *target = std::move(value);
+    return old;
+  }
+
+  constexpr void rollback(std::vector<undo_entry>& log)
+  {
+    for (auto& entry : log | std::views::reverse) {
+      switch (entry.op) {
+        case patch_op::add: add_at(std::move(entry.path), std::move(entry.value)); break;
+        case patch_op::remove: remove_at(entry.path); break;
+        case patch_op::replace: replace_at(entry.path, std::move(entry.value)); break;
+        case patch_op::move: {
+          auto moved = entry.replaced ? replace_at(entry.path, std::move(entry.value)) : remove_at(entry.path);
+          add_at(std::move(entry.from), *std::move(moved));
+          break;
+        }
+      }
+    }
+  }
+
+  static constexpr bool is_number(json_value_kind kind) noexcept
+  {
+    return kind == json_value_kind::number_signed_integer || kind == json_value_kind::number_unsigned_integer
+        || kind == json_value_kind::number_floating_point;
+  }
+
+  constexpr std::optional<patch_failure> apply_patch_impl(basic_json patch)
+  {
+    if (patch.kind_ != json_value_kind::array) return patch_failure{"JSON Patch must be an array", 0};
+
+    std::vector<undo_entry> log;
+    auto const fail = [&](char const* message, std::size_t index) -> std::optional<patch_failure> {
+      rollback(log);
+      return patch_failure{message, index};
+    };
+
+    auto& operations = std::get<1>(patch.data_);
+    for (std::size_t index = 0; index < operations.size(); ++index) {
+      auto& operation = operations[index];
+      if (operation.kind_ != json_value_kind::object) return fail("JSON Patch operation must be an object", index);
+
+      auto const member = [&](std::basic_string_view<charT> name) -> basic_json* {
+        auto iter = operation.find_member(name);
+        return iter == std::get<2>(operation.data_).end() ? nullptr : &iter->second;
+      };
+      auto const pointer_member = [&](std::basic_string_view<charT> name) -> std::optional<pointer_type> {
+        basic_json const* m = member(name);
+        if (!m || m->kind_ != json_value_kind::string) return std::nullopt;
+        return parse_pointer(std::get<0>(m->data_));
+      };
+
+      basic_json const* op = member(YK_JSON20_WIDEN_STRING(charT, "op"));
+      if (!op || op->kind_ != json_value_kind::string) return fail("JSON Patch operation has no \"op\"", index);
+      auto path = pointer_member(YK_JSON20_WIDEN_STRING(charT, "path"));
+      if (!path) return fail("JSON Patch operation has an invalid \"path\"", index);
+      basic_json* value = member(YK_JSON20_WIDEN_STRING(charT, "value"));
+      std::basic_string_view<charT> const name = std::get<0>(op->data_);
+
+      if (name == YK_JSON20_WIDEN_STRING(charT, "add")) {
+        if (!value) return fail("JSON Patch \"add\" has no \"value\"", index);
+        auto undo = add_at(std::move(*path), std::move(*value));
+        if (!undo) return fail("JSON Patch \"add\" target does not exist", index);
+        log.push_back(*std::move(undo));
+      } else if (name == YK_JSON20_WIDEN_STRING(charT, "remove")) {
+        auto removed = remove_at(*path);
+        if (!removed) return fail("JSON Patch \"remove\" target does not exist", index);
+        log.push_back({patch_op::add, std::move(*path), {}, *std::move(removed)});
+      } else if (name == YK_JSON20_WIDEN_STRING(charT, "replace")) {
+        if (!value) return fail("JSON Patch \"replace\" has no \"value\"", index);
+        auto old = replace_at(*path, std::move(*value));
+        if (!old) return fail("JSON Patch \"replace\" target does not exist", index);
+        log.push_back({patch_op::replace, std::move(*path), {}, *std::move(old)});
+      } else if (name == YK_JSON20_WIDEN_STRING(charT, "move")) {
+        auto from = pointer_member(YK_JSON20_WIDEN_STRING(charT, "from"));
+        if (!from) return fail("JSON Patch \"move\" has an invalid \"from\"", index);
+        if (from->size() < path->size() && std::ranges::equal(*from, std::span(*path).first(from->size())))
+          return fail("JSON Patch \"move\" into its own child", index);
+        auto moved = remove_at(*from);
+        if (!moved) return fail("JSON Patch \"move\" source does not exist", index);
+        auto undo = add_at(*path, std::move(*moved));
+        if (!undo) {
+          add_at(std::move(*from), std::move(*moved));
+          return fail("JSON Patch \"move\" target does not exist", index);
+        }
+        // the inverse of add_at() reports the position the value was actually inserted at (e.g. "-" resolved to an index)
+        bool const replaced = undo->op == patch_op::replace;
+        log.push_back({patch_op::move, std::move(undo->path), std::move(*from), std::move(undo->value), replaced});
+      } else if (name == YK_JSON20_WIDEN_STRING(charT, "copy")) {
+        auto from = pointer_member(YK_JSON20_WIDEN_STRING(charT, "from"));
+        if (!from) return fail("JSON Patch \"copy\" has an invalid \"from\"", index);
+        basic_json const* source = resolve(*from);
+        if (!source) return fail("JSON Patch \"copy\" source does not exist", index);
+        auto undo = add_at(std::move(*path), basic_json(*source));
+        if (!undo) return fail("JSON Patch \"copy\" target does not exist", index);
+        log.push_back(*std::move(undo));
+      } else if (name == YK_JSON20_WIDEN_STRING(charT, "test")) {
+        if (!value) return fail("JSON Patch \"test\" has no \"value\"", index);
+        basic_json const* target = resolve(*path);
+        if (!target || *target != *value) return fail("JSON Patch \"test\" failed", index);
+      } else {
+        return fail("JSON Patch operation has an unknown \"op\"", index);
+      }
+    }
+    return std::nullopt;
+  }
+
+  json_value_kind kind_;
+  std::variant<std::basic_string<charT>, std::vector<basic_json>, std::vector<std::pair<std::basic_string<charT>, basic_json>>> data_;
+};
+
+using json = basic_json<char>;
+using wjson = basic_json<wchar_t>;
+using u8json = basic_json<char8_t>;
+using u16json = basic_json<char16_t>;
+using u32json = basic_json<char32_t>;
+
+template<class charT, class StatsT = void>
+class basic_json_visitor {
+public:
+  constexpr basic_json_visitor() = default;
+
+  template<class S>
+    requires(!std::is_void_v<StatsT> && std::same_as<S, StatsT>)
+  constexpr explicit basic_json_visitor(S& stats) noexcept : stats_(&stats)
+  {
+  }
+
+  constexpr void on_null(std::basic_string_view<charT> str) { push_value(json_value_kind::null, str); }
+  constexpr void on_boolean(std::basic_string_view<charT> str) { push_value(json_value_kind::boolean, str); }
+  constexpr void on_number_unsigned_integer(std::basic_string_view<charT> str) { push_value(json_value_kind::number_unsigned_integer, str); }
+  constexpr void on_number_signed_integer(std::basic_string_view<charT> str) { push_value(json_value_kind::number_signed_integer, str); }
+  constexpr void on_number_floating_point(std::basic_string_view<charT> str) { push_value(json_value_kind::number_floating_point, str); }
+  constexpr void on_string(std::basic_string_view<charT> str) { push_value(json_value_kind::string, str); }
+
+  // tokens produced by a parser for another character type are transcoded once, directly into the node
+  template<class charT2>
+  constexpr void on_null(std::basic_string_view<charT2> str)
+  {
+    push_value(json_value_kind::null, str);
+  }
+  template<class charT2>
+  constexpr void on_boolean(std::basic_string_view<charT2> str)
+  {
+    push_value(json_value_kind::boolean, str);
+  }
+  template<class charT2>
+  constexpr void on_number_unsigned_integer(std::basic_string_view<charT2> str)
+  {
+    push_value(json_value_kind::number_unsigned_integer, str);
+  }
+  template<class charT2>
+  constexpr void on_number_signed_integer(std::basic_string_view<charT2> str)
+  {
+    push_value(json_value_kind::number_signed_integer, str);
+  }
+  template<class charT2>
+  constexpr void on_number_floating_point(std::basic_string_view<charT2> str)
+  {
+    push_value(json_value_kind::number_floating_point, str);
+  }
+  template<class charT2>
+  constexpr void on_string(std::basic_string_view<charT2> str)
+  {
+    push_value(json_value_kind::string, str);
+  }
+
+  constexpr void on_array_start() { push_start(); }
+  constexpr void on_array_finalize()
+  {
+    auto i = std::ranges::find_if(stack_ | std::views::reverse, [](auto const& var) { return std::holds_alternative<start_tag>(var); }).base();
+    std::vector<basic_json<charT>> vec;
+    for (auto j = i; j != stack_.end(); ++j) {
+      auto const capacity = vec.capacity();
+      vec.emplace_back(std::get<basic_json<charT>>(std::move(*j)));
+      record_growth(vec, capacity);
+    }
+    stack_.erase(i - 1, stack_.end());
+    stack_.emplace_back(std::in_place_index<1>, basic_json<charT>::private_construct, json_value_kind::array, std::in_place_index<1>, std::move(vec));
+  }
+  constexpr void on_array_abort()
+  {
+    auto i = std::ranges::find_if(stack_ | std::views::reverse, [](auto const& var) { return std::holds_alternative<start_tag>(var); }).base();
+    stack_.erase(i - 1, stack_.end());
+  }
+
+  constexpr void on_object_start() { push_start(); }
+  constexpr void on_object_finalize()
+  {
+    auto i = std::ranges::find_if(stack_ | std::views::reverse, [](auto const& var) { return std::holds_alternative<start_tag>(var); }).base();
+    std::vector<std::pair<std::basic_string<charT>, basic_json<charT>>> vec;
+    for (auto j = i; j != stack_.end(); j += 2) {
+      auto const capacity = vec.capacity();
+      auto& key = std::get<basic_json<charT>>(*j);
+      if (key.get_kind() != json_value_kind::string) throw bad_json_access{};
+      vec.emplace_back(std::get<0>(std::move(key.data_)), std::get<basic_json<charT>>(std::move(*(j + 1))));
+      record_growth(vec, capacity);
+    }
+    std::ranges::sort(vec, {}, &std::pair<std::basic_string<charT>, basic_json<charT>>::first);
+    stack_.erase(i - 1, stack_.end());
+    stack_.emplace_back(std::in_place_index<1>, basic_json<charT>::private_construct, json_value_kind::object, std::in_place_index<2>, std::move(vec));
+  }
+  constexpr void on_object_abort()
+  {
+    auto i = std::ranges::find_if(stack_ | std::views::reverse, [](auto const& var) { return std::holds_alternative<start_tag>(var); }).base();
+    stack_.erase(i - 1, stack_.end());
+  }
+
+  constexpr basic_json<charT> get() const&
+  {
+    assert(stack_.size() == 1);
+    return std::get<basic_json<charT>>(stack_.back());
+  }
+
+  constexpr basic_json<charT> get() &&
+  {
+    assert(stack_.size() == 1);
+    return std::get<basic_json<charT>>(std::move(stack_.back()));
+  }
+
+  // discards any partially built document but keeps the capacity of the internal stack
+  constexpr void clear() noexcept { stack_.clear(); }
+
+  constexpr void shrink_to_fit() { stack_.shrink_to_fit(); }
+
+  constexpr std::size_t capacity() const noexcept { return stack_.capacity(); }
+
+private:
+  static constexpr bool collects_stats = !std::is_void_v<StatsT>;
+
+  constexpr void record_allocation([[maybe_unused]] std::size_t bytes) noexcept
+  {
+    if constexpr (collects_stats) {
+      ++stats_->allocations;
+      stats_->bytes_allocated += bytes;
+    }
+  }
+
+  template<class T>
+  constexpr void record_growth([[maybe_unused]] std::vector<T> const& vec, [[maybe_unused]] std::size_t old_capacity) noexcept
+  {
+    if constexpr (collects_stats) {
+      if (vec.capacity() != old_capacity) record_allocation(vec.capacity() * sizeof(T));
+    }
+  }
+
+  constexpr void record_string([[maybe_unused]] std::basic_string<charT> const& str) noexcept
+  {
+    if constexpr (collects_stats) {
+      if (str.capacity() > std::basic_string<charT>{}.capacity()) record_allocation((str.capacity() + 1) * sizeof(charT));
+    }
+  }
+
+  constexpr void push_start()
+  {
+    auto const capacity = stack_.capacity();
+    stack_.emplace_back(start_tag{});
+    record_growth(stack_, capacity);
+  }
+
+  template<class charT2>
+  constexpr void push_value(json_value_kind kind, std::basic_string_view<charT2> str)
+  {
+    auto const capacity = stack_.capacity();
+    if constexpr (std::is_same_v<charT2, charT>) {
+      stack_.emplace_back(std::in_place_index<1>, basic_json<charT>::private_construct, kind, std::in_place_index<0>, str.begin(), str.end());
+    } else {
+      stack_.emplace_back(std::in_place_index<1>, basic_json<charT>::private_construct, kind, std::in_place_index<0>, detail::transcode<charT>(str));
+    }
+    record_growth(stack_, capacity);
+    if constexpr (collects_stats) record_string(std::get<0>(std::get<basic_json<charT>>(stack_.back()).data_));
+  }
+
+  struct start_tag {};
+  std::vector<std::variant<start_tag, basic_json<charT>>> stack_;
+
+  struct no_stats {};
+  [[no_unique_address]] std::conditional_t<collects_stats, StatsT*, no_stats> stats_{};
+};
+
+using json_visitor = basic_json_visitor<char>;
+using wjson_visitor = basic_json_visitor<wchar_t>;
+using u8json_visitor = basic_json_visitor<char8_t>;
+using u16json_visitor = basic_json_visitor<char16_t>;
+using u32json_visitor = basic_json_visitor<char32_t>;
+
+// destination for the chunks produced by basic_json_writer; a sink may also provide flush()
+template<class Sink, class charT>
+concept json_sink = requires(Sink& sink, std::basic_string_view<charT> chunk) { sink.write(chunk); };
+
+// writes to a C stream; fails with std::system_error if the stream reports an error
+template<class charT>
+class basic_file_sink {
+public:
+  explicit basic_file_sink(std::FILE* file) noexcept : file_(file) {}
+
+  void write(std::basic_string_view<charT> chunk)
+  {
+    if (std::fwrite(chunk.data(), sizeof(charT), chunk.size(), file_) != chunk.size()) throw std::system_error(errno, std::generic_category(), "fwrite");
+  }
+
+  void flush()
+  {
+    if (std::fflush(file_) != 0) throw std::system_error(errno, std::generic_category(), "fflush");
+  }
+
+private:
+  std::FILE* file_;
+};
+
+using file_sink = basic_file_sink<char>;
+using wfile_sink = basic_file_sink<wchar_t>;
+
+// writes to an output stream; errors are reported through the stream's state and exception mask
+template<class charT, class Traits = std::char_traits<charT>>
+class basic_ostream_sink {
+public:
+  explicit basic_ostream_sink(std::basic_ostream<charT, Traits>& os) noexcept : os_(&os) {}
+
+  void write(std::basic_string_view<charT> chunk) { os_->write(chunk.data(), static_cast<std::streamsize>(chunk.size())); }
+
+  void flush() { os_->flush(); }
+
+private:
+  std::basic_ostream<charT, Traits>* os_;
+};
+
+using ostream_sink = basic_ostream_sink<char>;
+using wostream_sink = basic_ostream_sink<wchar_t>;
+
+struct json_writer_options {
+  std::size_t indent = 0;              // spaces per nesting level; 0 writes compact output
+  std::size_t chunk_size = 64 * 1024;  // code units buffered before they are handed to the sink
+};
+
+// emits JSON text from a sequence of begin/key/value/end calls without building a basic_json.
+// with Sink = void the output accumulates in an internal buffer; otherwise it is handed to the sink in chunks
+// of roughly options.chunk_size code units. the writer is also a parser visitor, so
+// basic_json_parser<charT>::parse(writer, text) reformats text without a DOM.
+// call sequences that do not form a single JSON value are caught by assertions
+template<class charT, class Sink = void>
+class basic_json_writer {
+  static constexpr bool has_sink = !std::is_void_v<Sink>;
+
+public:
+  constexpr basic_json_writer()
+    requires(!has_sink)
+  = default;
+
+  constexpr explicit basic_json_writer(json_writer_options options)
+    requires(!has_sink)
+      : options_(options)
+  {
+  }
+
+  template<class S = Sink>
+    requires(has_sink && json_sink<S, charT>)
+  constexpr explicit basic_json_writer(S sink, json_writer_options options = {}) : sink_(std::move(sink)), options_(options)
+  {
+    buffer_.reserve(options_.chunk_size);
+  }
+
+  basic_json_writer(basic_json_writer const&) = delete;
+  basic_json_writer& operator=(basic_json_writer const&) = delete;
+
+  // hands any buffered output to the sink; errors are ignored here, so call flush() to observe them
+  constexpr ~basic_json_writer()
+  {
+    if constexpr (has_sink) {
+      try {
+        flush();
+      } catch (...) {
+      }
+    }
+  }
+
+  constexpr basic_json_writer& begin_object() { return open(true, U'{'); }
+  constexpr basic_json_writer& end_object() { return close(true, U'}'); }
+  constexpr basic_json_writer& begin_array() { return open(false, U'['); }
+  constexpr basic_json_writer& end_array() { return close(false, U']'); }
+
+  constexpr basic_json_writer& key(std::basic_string_view<charT> name)
+  {
+    assert(!stack_.empty() && stack_.back().object && !after_key_);
+    separate(stack_.back());
+    put_string(name);
+    put(U':');
+    if (options_.indent != 0) put(U' ');
+    after_key_ = true;
+    return *this;
+  }
+
+  constexpr basic_json_writer& value(std::nullptr_t) { return scalar(YK_JSON20_WIDEN_STRING(charT, "null")); }
+
+  constexpr basic_json_writer& value(bool x) { return scalar(x ? serializer<bool, charT>::true_ : serializer<bool, charT>::false_); }
+
+  template<class T>
+    requires(std::integral<T> && !std::same_as<T, bool>) || std::floating_point<T>
+  constexpr basic_json_writer& value(T x)
+  {
+    if constexpr (std::floating_point<T>) {
+      if (!(x - x == 0)) throw std::invalid_argument("JSON cannot represent infinity or NaN");
+    }
+    char buf[serializer<T, charT>::buffer_size];
+    auto [ptr, ec] = std::to_chars(std::begin(buf), std::end(buf), x);
+    if (ec != std::errc{}) throw std::runtime_error("to_chars error");
+    before_value();
+    buffer_.append(std::begin(buf), ptr);
+    return after_value();
+  }
+
+  template<class S>
+    requires std::is_convertible_v<S const&, std::basic_string_view<charT>>
+  constexpr basic_json_writer& value(S const& str)
+  {
+    before_value();
+    put_string(str);
+    return after_value();
+  }
+
+  constexpr basic_json_writer& value(basic_json<charT> const& json)
+  {
+    switch (json.get_kind()) {
+      case json_value_kind::string: return value(json.as_string_unchecked());
+      case json_value_kind::array:
+        begin_array();
+        for (auto const& element : json.as_array_unchecked()) value(element);
+        return end_array();
+      case json_value_kind::object:
+        begin_object();
+        for (auto const& [name, member] : json.as_object_unchecked()) key(name).value(member);
+        return end_object();
+      default: return scalar(json.as_string_unchecked());  // null, boolean and numbers are stored as their JSON text
+    }
+  }
+
+  // visitor interface; scalar tokens are copied verbatim
+  constexpr void on_null(std::basic_string_view<charT> str) { scalar(str); }
+  constexpr void on_boolean(std::basic_string_view<charT> str) { scalar(str); }
+  constexpr void on_number_unsigned_integer(std::basic_string_view<charT> str) { scalar(str); }
+  constexpr void on_number_signed_integer(std::basic_string_view<charT> str) { scalar(str); }
+  constexpr void on_number_floating_point(std::basic_string_view<charT> str) { scalar(str); }
+  constexpr void on_string(std::basic_string_view<charT> str) { value(str); }
+  constexpr void on_key(std::basic_string_view<charT> str) { key(str); }
 
-  static constexpr basic_json object(std::initializer_list<std::pair<std::basic_string<charT>, basic_json>> il) { return basic_json(std::move(il)); }
+  constexpr void on_array_start() { begin_array(); }
+  constexpr void on_array_finalize() { end_array(); }
+  constexpr void on_array_abort() { abort(); }
 
-private:
-  json_value_kind kind_;
-  std::variant<std::basic_string<charT>, std::vector<basic_json>, std::vector<std::pair<std::basic_string<charT>, basic_json>>> data_;
-};
+  constexpr void on_object_start() { begin_object(); }
+  constexpr void on_object_finalize() { end_object(); }
+  constexpr void on_object_abort() { abort(); }
 
-using json = basic_json<char>;
-using wjson = basic_json<wchar_t>;
-using u8json = basic_json<char8_t>;
-using u16json = basic_json<char16_t>;
-using u32json = basic_json<char32_t>;
+  // true once a complete top-level value has been written
+  constexpr bool done() const noexcept { return done_; }
 
-template<class charT>
-class basic_json_visitor {
-public:
-  constexpr void on_null(std::basic_string_view<charT> str)
+  constexpr std::size_t depth() const noexcept { return stack_.size(); }
+
+  // the output produced so far
+  constexpr std::basic_string_view<charT> view() const noexcept
+    requires(!has_sink)
   {
-    stack_.emplace_back(std::in_place_index<1>, basic_json<charT>::private_construct, json_value_kind::null, std::in_place_index<0>, str.begin(), str.end());
+    return buffer_;
   }
-  constexpr void on_boolean(std::basic_string_view<charT> str)
+
+  constexpr std::basic_string<charT> str() &&
+    requires(!has_sink)
   {
-    stack_.emplace_back(std::in_place_index<1>, basic_json<charT>::private_construct, json_value_kind::boolean, std::in_place_index<0>, str.begin(), str.end());
+    return std::move(buffer_);
   }
-  constexpr void on_number_unsigned_integer(std::basic_string_view<charT> str)
+
+  constexpr void flush()
+    requires has_sink
   {
-    stack_.emplace_back(
-        std::in_place_index<1>, basic_json<charT>::private_construct, json_value_kind::number_unsigned_integer, std::in_place_index<0>, str.begin(), str.end()
-    );
+    if (!buffer_.empty()) {
+      sink_.write(buffer_);
+      buffer_.clear();
+    }
+    if constexpr (requires { sink_.flush(); }) sink_.flush();
   }
-  constexpr void on_number_signed_integer(std::basic_string_view<charT> str)
+
+  // starts a new document; buffered output that has not reached the sink is discarded
+  constexpr void clear() noexcept
   {
-    stack_.emplace_back(
-        std::in_place_index<1>, basic_json<charT>::private_construct, json_value_kind::number_signed_integer, std::in_place_index<0>, str.begin(), str.end()
-    );
+    buffer_.clear();
+    stack_.clear();
+    after_key_ = false;
+    done_ = false;
   }
-  constexpr void on_number_floating_point(std::basic_string_view<charT> str)
+
+private:
+  struct frame {
+    bool object;
+    bool empty = true;
+  };
+
+  // structural characters are ASCII, which is a single code unit in every encoding form
+  constexpr void put(char32_t c) { buffer_.push_back(static_cast<charT>(c)); }
+
+  constexpr void newline()
   {
-    stack_.emplace_back(
-        std::in_place_index<1>, basic_json<charT>::private_construct, json_value_kind::number_floating_point, std::in_place_index<0>, str.begin(), str.end()
-    );
+    if (options_.indent == 0) return;
+    put(U'\n');
+    buffer_.append(stack_.size() * options_.indent, static_cast<charT>(U' '));
   }
-  constexpr void on_string(std::basic_string_view<charT> str)
+
+  constexpr void separate(frame& top)
   {
-    stack_.emplace_back(std::in_place_index<1>, basic_json<charT>::private_construct, json_value_kind::string, std::in_place_index<0>, str.begin(), str.end());
+    if (!top.empty) put(U',');
+    top.empty = false;
+    newline();
   }
 
-  constexpr void on_array_start() { stack_.emplace_back(start_tag{}); }
-  constexpr void on_array_finalize()
+  constexpr void before_value()
   {
-    auto i = std::ranges::find_if(stack_ | std::views::reverse, [](auto const& var) { return std::holds_alternative<start_tag>(var); }).base();
-    std::vector<basic_json<charT>> vec;
-    for (auto j = i; j != stack_.end(); ++j) {
-      vec.emplace_back(std::get<basic_json<charT>>(std::move(*j)));
+    if (stack_.empty()) {
+      assert(!done_);
+      return;
+    }
+    if (stack_.back().object) {
+      assert(after_key_);
+      after_key_ = false;
+    } else {
+      separate(stack_.back());
     }
-    stack_.erase(i - 1, stack_.end());
-    stack_.emplace_back(std::in_place_index<1>, basic_json<charT>::private_construct, json_value_kind::array, std::in_place_index<1>, std::move(vec));
-  }
-  constexpr void on_array_abort()
-  {
-    auto i = std::ranges::find_if(stack_ | std::views::reverse, [](auto const& var) { return std::holds_alternative<start_tag>(var); }).base();
-    stack_.erase(i - 1, stack_.end());
   }
 
-  constexpr void on_object_start() { stack_.emplace_back(start_tag{}); }
-  constexpr void on_object_finalize()
+  constexpr basic_json_writer& after_value()
   {
-    auto i = std::ranges::find_if(stack_ | std::views::reverse, [](auto const& var) { return std::holds_alternative<start_tag>(var); }).base();
-    std::vector<std::pair<std::basic_string<charT>, basic_json<charT>>> vec;
-    for (auto j = i; j != stack_.end(); j += 2) {
-      vec.emplace_back(std::get<basic_json<charT>>(*j).as_string(), std::get<basic_json<charT>>(*(j + 1)));
+    if (stack_.empty()) done_ = true;
+    if constexpr (has_sink) {
+      if (buffer_.size() >= options_.chunk_size) {
+        sink_.write(buffer_);
+        buffer_.clear();
+      }
     }
-    std::ranges::sort(vec, {}, &std::pair<std::basic_string<charT>, basic_json<charT>>::first);
-    stack_.erase(i - 1, stack_.end());
-    stack_.emplace_back(std::in_place_index<1>, basic_json<charT>::private_construct, json_value_kind::object, std::in_place_index<2>, std::move(vec));
+    return *this;
   }
-  constexpr void on_object_abort()
+
+  constexpr basic_json_writer& scalar(std::basic_string_view<charT> text)
   {
-    auto i = std::ranges::find_if(stack_ | std::views::reverse, [](auto const& var) { return std::holds_alternative<start_tag>(var); }).base();
-    stack_.erase(i - 1, stack_.end());
+    before_value();
+    buffer_.append(text);
+    return after_value();
   }
 
-  constexpr basic_json<charT> get() const
+  constexpr basic_json_writer& open(bool object, char32_t bracket)
   {
-    assert(stack_.size() == 1);
-    return std::get<basic_json<charT>>(stack_.back());
+    before_value();
+    put(bracket);
+    stack_.push_back({object});
+    return *this;
   }
 
-private:
-  struct start_tag {};
-  std::vector<std::variant<start_tag, basic_json<charT>>> stack_;
+  constexpr basic_json_writer& close([[maybe_unused]] bool object, char32_t bracket)
+  {
+    assert(!stack_.empty() && stack_.back().object == object && !after_key_);
+    bool const empty = stack_.back().empty;
+    stack_.pop_back();
+    if (!empty) newline();
+    put(bracket);
+    return after_value();
+  }
+
+  // the parser gave up on the innermost container and the whole parse is about to fail
+  constexpr void abort()
+  {
+    stack_.pop_back();
+    after_key_ = false;
+  }
+
+  constexpr void put_string(std::basic_string_view<charT> str)
+  {
+    put(U'"');
+    std::size_t pos = 0;
+    while (true) {
+      std::size_t const special = detail::find_string_special(str, pos);
+      buffer_.append(str.substr(pos, special - pos));
+      if (special == str.size()) break;
+      char32_t const c = detail::to_code_unit(str[special]);
+      put(U'\\');
+      switch (c) {
+        case U'"': put(U'"'); break;
+        case U'\\': put(U'\\'); break;
+        case U'\b': put(U'b'); break;
+        case U'\f': put(U'f'); break;
+        case U'\n': put(U'n'); break;
+        case U'\r': put(U'r'); break;
+        case U'\t': put(U't'); break;
+        default:
+          put(U'u');
+          put(U'0');
+          put(U'0');
+          put(U"0123456789abcdef"[c >> 4]);
+          put(U"0123456789abcdef"[c & 0xF]);
+      }
+      pos = special + 1;
+    }
+    put(U'"');
+  }
+
+  struct no_sink {};
+  [[no_unique_address]] std::conditional_t<has_sink, Sink, no_sink> sink_{};
+  json_writer_options options_{};
+  std::basic_string<charT> buffer_;
+  std::vector<frame> stack_;
+  bool after_key_ = false;
+  bool done_ = false;
 };
 
-using json_visitor = basic_json_visitor<char>;
-using wjson_visitor = basic_json_visitor<wchar_t>;
-using u8json_visitor = basic_json_visitor<char8_t>;
-using u16json_visitor = basic_json_visitor<char16_t>;
-using u32json_visitor = basic_json_visitor<char32_t>;
+using json_writer = basic_json_writer<char>;
+using wjson_writer = basic_json_writer<wchar_t>;
+using u8json_writer = basic_json_writer<char8_t>;
+using u16json_writer = basic_json_writer<char16_t>;
+using u32json_writer = basic_json_writer<char32_t>;
+
+template<class charT>
+struct serializer<basic_json<charT>, charT> {
+  static constexpr std::basic_string<charT> serialize(basic_json<charT> const& x, json_writer_options options = {})
+  {
+    basic_json_writer<charT> writer(options);
+    writer.value(x);
+    return std::move(writer).str();
+  }
+};
+
+template<class charT>
+class basic_reusable_json_parser;
 
 template<class charT>
 class basic_json_parser {
@@ -579,6 +1920,8 @@ public:
   };
 
 private:
+  friend class basic_reusable_json_parser<charT>;
+
   struct lit_parser {
     std::basic_string_view<charT> literal;
 
@@ -703,11 +2046,26 @@ private:
     };
   }
 
+  // like many(), but only reports the consumed span instead of collecting every match
+  template<class Parser>
+  static constexpr auto skip_many(Parser const& p) noexcept
+  {
+    return [p](std::basic_string_view<charT> str) -> parse_result<> {
+      auto rest = str;
+      while (true) {
+        auto res = p(rest);
+        if (!res.match) break;
+        rest = res.rest;
+      }
+      return {std::basic_string_view<charT>{str.begin(), rest.begin()}, rest};
+    };
+  }
+
   template<class Parser, class Delim>
   static constexpr auto sep_by(Parser const& p, Delim const& d) noexcept
   {
     return [p, d](std::basic_string_view<charT> str) -> parse_result<> {
-      if (auto res = seq(p, many(seq(d, p)))(str); res.match) {
+      if (auto res = seq(p, skip_many(seq(d, p)))(str); res.match) {
         return {std::basic_string_view<charT>{str.begin(), res.rest.begin()}, res.rest};
       }
       return {std::nullopt, str};
@@ -721,103 +2079,198 @@ private:
     auto const cr = YK_JSON20_WIDEN_STRING(charT, "\r");
     auto const tab = YK_JSON20_WIDEN_STRING(charT, "\t");
 
-    auto const parser = many(alt(lit(space), lit(lf), lit(cr), lit(tab)));
-    auto res = parser(str);
-    return {std::basic_string_view<charT>{str.begin(), res.rest.begin()}, res.rest};
-  }
-
-  static constexpr parse_result<> cntrl(std::basic_string_view<charT> str) noexcept
-  {
-    auto const control_characters_parser = alt(
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x00")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x01")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x02")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x03")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x04")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x05")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x06")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x07")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x08")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x09")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x0A")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x0B")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x0C")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x0D")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x0E")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x0F")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x00")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x11")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x12")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x13")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x14")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x15")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x16")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x17")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x18")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x19")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x1A")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x1B")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x1C")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x1D")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x1E")),  //
-        lit(YK_JSON20_WIDEN_STRING(charT, "\x1F"))   //
-    );
-
-    return control_characters_parser(str);
-  }
-
-#define YK_JSON20_INVOKE_VISITOR_ARG2(vis, member)   \
-  if constexpr (requires { vis.member##_raw(); }) {  \
-    vis.member##_raw();                              \
-  } else if constexpr (requires { vis.member(); }) { \
-    vis.member();                                    \
+    return skip_many(alt(lit(space), lit(lf), lit(cr), lit(tab)))(str);
   }
 
-#define YK_JSON20_INVOKE_VISITOR_ARG3(vis, member, raw_arg) \
-  if constexpr (requires { vis.member##_raw(raw_arg); }) {  \
-    vis.member##_raw(raw_arg);                              \
-  } else if constexpr (requires { vis.member(); }) {        \
-    vis.member();                                           \
+  template<class F>
+  static constexpr visit_action to_visit_action(F const& f)
+  {
+    if constexpr (std::is_void_v<std::invoke_result_t<F const&>>) {
+      f();
+      return visit_action::proceed;
+    } else {
+      return f();
+    }
   }
 
-#define YK_JSON20_INVOKE_VISITOR_ARG4(vis, member, normal_arg, raw_arg) \
-  if constexpr (requires { vis.member##_raw(normal_arg, raw_arg); }) {  \
-    vis.member##_raw(normal_arg, raw_arg);                              \
-  } else if constexpr (requires { vis.member(normal_arg); }) {          \
-    vis.member(normal_arg);                                             \
-  }
+  // each of these evaluates to the visit_action returned by the callback, or proceed if the visitor has no such callback
+#define YK_JSON20_INVOKE_VISITOR_ARG2(vis, member)                            \
+  [&]() -> visit_action {                                                     \
+    if constexpr (requires { vis.member##_raw(); }) {                         \
+      return to_visit_action([&] { return vis.member##_raw(); });             \
+    } else if constexpr (requires { vis.member(); }) {                        \
+      return to_visit_action([&] { return vis.member(); });                   \
+    } else {                                                                  \
+      return visit_action::proceed;                                           \
+    }                                                                         \
+  }()
+
+#define YK_JSON20_INVOKE_VISITOR_ARG3(vis, member, raw_arg)                   \
+  [&]() -> visit_action {                                                     \
+    if constexpr (requires { vis.member##_raw(raw_arg); }) {                  \
+      return to_visit_action([&] { return vis.member##_raw(raw_arg); });      \
+    } else if constexpr (requires { vis.member(); }) {                        \
+      return to_visit_action([&] { return vis.member(); });                   \
+    } else {                                                                  \
+      return visit_action::proceed;                                           \
+    }                                                                         \
+  }()
+
+#define YK_JSON20_INVOKE_VISITOR_ARG4(vis, member, normal_arg, raw_arg)         \
+  [&]() -> visit_action {                                                       \
+    if constexpr (requires { vis.member##_raw(normal_arg, raw_arg); }) {        \
+      return to_visit_action([&] { return vis.member##_raw(normal_arg, raw_arg); }); \
+    } else if constexpr (requires { vis.member(normal_arg); }) {                \
+      return to_visit_action([&] { return vis.member(normal_arg); });           \
+    } else {                                                                    \
+      return visit_action::proceed;                                             \
+    }                                                                           \
+  }()
 
 #define YK_JSON20_INVOKE_VISITOR_SELECTER(_1, _2, _3, _4, _5, ...) _5
 #define YK_JSON20_INVOKE_VISITOR(...) \
   YK_JSON20_INVOKE_VISITOR_SELECTER(__VA_ARGS__, YK_JSON20_INVOKE_VISITOR_ARG4, YK_JSON20_INVOKE_VISITOR_ARG3, YK_JSON20_INVOKE_VISITOR_ARG2)(__VA_ARGS__)
 
+  // visitors without an on_key callback receive object keys through on_string
+  template<class Visitor>
+  static constexpr bool has_on_key = requires(Visitor& vis, std::basic_string_view<charT> str) { vis.on_key_raw(str, str); } ||
+                                     requires(Visitor& vis, std::basic_string_view<charT> str) { vis.on_key(str); };
+
+  // forwards every event to `vis` while counting tokens and tracking the nesting depth
+  template<class Visitor>
+  struct stats_visitor {
+    Visitor& vis;
+    parse_stats& stats;
+    std::size_t depth = 0;
+
+    constexpr void count(json_value_kind kind) noexcept { ++stats.tokens[static_cast<std::size_t>(kind)]; }
+
+    constexpr void enter() noexcept { stats.max_depth = std::max(stats.max_depth, ++depth); }
+
+    constexpr visit_action on_null_raw(std::basic_string_view<charT> str, std::basic_string_view<charT> raw)
+    {
+      count(json_value_kind::null);
+      return YK_JSON20_INVOKE_VISITOR(vis, on_null, str, raw);
+    }
+    constexpr visit_action on_boolean_raw(std::basic_string_view<charT> str, std::basic_string_view<charT> raw)
+    {
+      count(json_value_kind::boolean);
+      return YK_JSON20_INVOKE_VISITOR(vis, on_boolean, str, raw);
+    }
+    constexpr visit_action on_number_unsigned_integer_raw(std::basic_string_view<charT> str, std::basic_string_view<charT> raw)
+    {
+      count(json_value_kind::number_unsigned_integer);
+      return YK_JSON20_INVOKE_VISITOR(vis, on_number_unsigned_integer, str, raw);
+    }
+    constexpr visit_action on_number_signed_integer_raw(std::basic_string_view<charT> str, std::basic_string_view<charT> raw)
+    {
+      count(json_value_kind::number_signed_integer);
+      return YK_JSON20_INVOKE_VISITOR(vis, on_number_signed_integer, str, raw);
+    }
+    constexpr visit_action on_number_floating_point_raw(std::basic_string_view<charT> str, std::basic_string_view<charT> raw)
+    {
+      count(json_value_kind::number_floating_point);
+      return YK_JSON20_INVOKE_VISITOR(vis, on_number_floating_point, str, raw);
+    }
+    constexpr visit_action on_string_raw(std::basic_string_view<charT> str, std::basic_string_view<charT> raw)
+    {
+      count(json_value_kind::string);
+      return YK_JSON20_INVOKE_VISITOR(vis, on_string, str, raw);
+    }
+    constexpr visit_action on_key_raw(std::basic_string_view<charT> str, std::basic_string_view<charT> raw)
+    {
+      count(json_value_kind::string);
+      if constexpr (has_on_key<Visitor>) {
+        return YK_JSON20_INVOKE_VISITOR(vis, on_key, str, raw);
+      } else {
+        return YK_JSON20_INVOKE_VISITOR(vis, on_string, str, raw);
+      }
+    }
+
+    constexpr visit_action on_array_start()
+    {
+      enter();
+      auto const action = YK_JSON20_INVOKE_VISITOR(vis, on_array_start);
+      if (action != visit_action::proceed) --depth;  // no finalize or abort follows
+      return action;
+    }
+    constexpr visit_action on_array_finalize_raw(std::basic_string_view<charT> raw)
+    {
+      --depth;
+      count(json_value_kind::array);
+      return YK_JSON20_INVOKE_VISITOR(vis, on_array_finalize, raw);
+    }
+    constexpr void on_array_abort()
+    {
+      --depth;
+      YK_JSON20_INVOKE_VISITOR(vis, on_array_abort);
+    }
+
+    constexpr visit_action on_object_start()
+    {
+      enter();
+      auto const action = YK_JSON20_INVOKE_VISITOR(vis, on_object_start);
+      if (action != visit_action::proceed) --depth;
+      return action;
+    }
+    constexpr visit_action on_object_finalize_raw(std::basic_string_view<charT> raw)
+    {
+      --depth;
+      count(json_value_kind::object);
+      return YK_JSON20_INVOKE_VISITOR(vis, on_object_finalize, raw);
+    }
+    constexpr void on_object_abort()
+    {
+      --depth;
+      YK_JSON20_INVOKE_VISITOR(vis, on_object_abort);
+    }
+  };
+
+  // per-call state shared by the parse_* functions; the buffer is scratch space for unescaping strings.
+  // `stopped` is set once the visitor returns visit_action::stop, after which every parse_* function fails
+  // immediately so that the combinators unwind without further events. `skip_value` is set when on_key
+  // asks to skip the member value that follows
   template<class Visitor>
-  static constexpr parse_result<> parse_null(Visitor& vis, std::basic_string_view<charT> str) noexcept
+  struct parse_context {
+    Visitor& vis;
+    std::basic_string<charT>& buffer;
+    bool stopped = false;
+    bool skip_value = false;
+  };
+
+  template<class Context>
+  static constexpr parse_result<> halt(Context& ctx, std::basic_string_view<charT> str) noexcept
+  {
+    ctx.stopped = true;
+    return {std::nullopt, str};
+  }
+
+  template<class Context>
+  static constexpr parse_result<> parse_null(Context& ctx, std::basic_string_view<charT> str) noexcept
   {
     constexpr auto null_string = YK_JSON20_WIDEN_STRING(charT, "null");
 
     auto res = lit(null_string)(str);
     if (res.match) {
-      YK_JSON20_INVOKE_VISITOR(vis, on_null, *res.match, *res.match)
+      if (YK_JSON20_INVOKE_VISITOR(ctx.vis, on_null, *res.match, *res.match) == visit_action::stop) return halt(ctx, str);
     }
     return res;
   }
 
-  template<class Visitor>
-  static constexpr parse_result<> parse_boolean(Visitor& vis, std::basic_string_view<charT> str) noexcept
+  template<class Context>
+  static constexpr parse_result<> parse_boolean(Context& ctx, std::basic_string_view<charT> str) noexcept
   {
     constexpr auto true_string = YK_JSON20_WIDEN_STRING(charT, "true");
     constexpr auto false_string = YK_JSON20_WIDEN_STRING(charT, "false");
 
     auto res = alt(lit(true_string), lit(false_string))(str);
     if (res.match) {
-      YK_JSON20_INVOKE_VISITOR(vis, on_boolean, *res.match, *res.match)
+      if (YK_JSON20_INVOKE_VISITOR(ctx.vis, on_boolean, *res.match, *res.match) == visit_action::stop) return halt(ctx, str);
     }
     return res;
   }
-
-  template<class Visitor>
-  static constexpr parse_result<> parse_number(Visitor& vis, std::basic_string_view<charT> str) noexcept
+  template<class Context>
+  static constexpr parse_result<> parse_number(Context& ctx, std::basic_string_view<charT> str) noexcept
   {
     auto const parse0 = lit(YK_JSON20_WIDEN_STRING(charT, "0"));
     auto const parse1to9 =
@@ -841,14 +2294,14 @@ private:
     auto const parse_dot = lit(YK_JSON20_WIDEN_STRING(charT, "."));
     auto const parse_e = alt(lit(YK_JSON20_WIDEN_STRING(charT, "e")), lit(YK_JSON20_WIDEN_STRING(charT, "E")));
 
-    auto const parse_frac = seq(parse_dot, many(parse0to9));
-    auto const parse_exp = seq(parse_e, opt(parse_sign), many(parse0to9));
+    auto const parse_frac = seq(parse_dot, skip_many(parse0to9));
+    auto const parse_exp = seq(parse_e, opt(parse_sign), skip_many(parse0to9));
 
     auto const res1 = parse_minus(str);
     bool const has_minus_sign = bool(res1.match);
     auto const int_frac_exp = res1.rest;
 
-    auto const parser = alt(parse0, seq(parse1to9, many(parse0to9)));
+    auto const parser = alt(parse0, seq(parse1to9, skip_many(parse0to9)));
 
     auto res2 = parser(int_frac_exp);
     if (res2.match) {
@@ -864,13 +2317,15 @@ private:
 
       std::basic_string_view<charT> match{str.begin(), rest.begin()};
 
+      visit_action action;
       if (has_frac || has_exp) {
-        YK_JSON20_INVOKE_VISITOR(vis, on_number_floating_point, match, match);
+        action = YK_JSON20_INVOKE_VISITOR(ctx.vis, on_number_floating_point, match, match);
       } else if (has_minus_sign) {
-        YK_JSON20_INVOKE_VISITOR(vis, on_number_signed_integer, match, match);
+        action = YK_JSON20_INVOKE_VISITOR(ctx.vis, on_number_signed_integer, match, match);
       } else {
-        YK_JSON20_INVOKE_VISITOR(vis, on_number_unsigned_integer, match, match);
+        action = YK_JSON20_INVOKE_VISITOR(ctx.vis, on_number_unsigned_integer, match, match);
       }
+      if (action == visit_action::stop) return halt(ctx, str);
 
       return {match, rest};
     } else {
@@ -878,109 +2333,192 @@ private:
     }
   }
 
-  template<class Visitor>
-  static constexpr parse_result<> parse_array(Visitor& vis, std::basic_string_view<charT> str) noexcept
+  template<class Context>
+  static constexpr parse_result<> parse_array(Context& ctx, std::basic_string_view<charT> str) noexcept
   {
     auto const open_bracket = YK_JSON20_WIDEN_STRING(charT, "[");
     auto const close_bracket = YK_JSON20_WIDEN_STRING(charT, "]");
     auto const comma = YK_JSON20_WIDEN_STRING(charT, ",");
 
-    auto const parser = seq(lit(open_bracket), alt(sep_by(std::bind_front(parse_value<Visitor>, std::ref(vis)), lit(comma)), ws), lit(close_bracket));
+    auto const parser = seq(lit(open_bracket), alt(sep_by(std::bind_front(parse_value<Context>, std::ref(ctx)), lit(comma)), ws), lit(close_bracket));
+
+    if (!str.starts_with(open_bracket)) return {std::nullopt, str};
 
-    YK_JSON20_INVOKE_VISITOR(vis, on_array_start)
+    switch (YK_JSON20_INVOKE_VISITOR(ctx.vis, on_array_start)) {
+      case visit_action::proceed: break;
+      case visit_action::skip: return skip_container(str);
+      case visit_action::stop: return halt(ctx, str);
+    }
     auto res = parser(str);
     if (res.match) {
       std::basic_string_view<charT> match{str.begin(), res.rest.begin()};
-      YK_JSON20_INVOKE_VISITOR(vis, on_array_finalize, match)
+      if (YK_JSON20_INVOKE_VISITOR(ctx.vis, on_array_finalize, match) == visit_action::stop) return halt(ctx, str);
       return {match, res.rest};
     }
-    YK_JSON20_INVOKE_VISITOR(vis, on_array_abort)
+    if (!ctx.stopped) YK_JSON20_INVOKE_VISITOR(ctx.vis, on_array_abort);
     return {std::nullopt, str};
   }
 
-  template<class Visitor>
-  static constexpr parse_result<> parse_string(Visitor& vis, std::basic_string_view<charT> str) noexcept
-  {
-    auto const quote = YK_JSON20_WIDEN_STRING(charT, "\"");
-    auto const backslash = YK_JSON20_WIDEN_STRING(charT, "\\");
-
-    // const auto hex = alt(
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "0")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "1")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "2")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "3")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "4")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "5")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "6")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "7")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "8")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "9")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "A")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "B")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "C")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "D")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "E")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "F")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "a")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "b")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "c")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "d")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "e")),  //
-    //     lit(YK_JSON20_WIDEN_STRING(charT, "f"))   //
-    // );
-
-    // TODO: implement unicode escape sequence
-    auto const escape_sequence = [&](std::basic_string_view<charT> s) -> parse_result<std::basic_string<charT>> {
-      if (!s.starts_with(backslash)) return {std::nullopt, s};
-      auto sequence = s.substr(backslash.size());
-
-      auto const slash = YK_JSON20_WIDEN_STRING(charT, "/");
-      auto const str_b = YK_JSON20_WIDEN_STRING(charT, "b");
-      auto const str_f = YK_JSON20_WIDEN_STRING(charT, "f");
-      auto const str_n = YK_JSON20_WIDEN_STRING(charT, "n");
-      auto const str_r = YK_JSON20_WIDEN_STRING(charT, "r");
-      auto const str_t = YK_JSON20_WIDEN_STRING(charT, "t");
-      auto const backspace = YK_JSON20_WIDEN_STRING(charT, "\b");
-      auto const formfeed = YK_JSON20_WIDEN_STRING(charT, "\f");
-      auto const linefeed = YK_JSON20_WIDEN_STRING(charT, "\n");
-      auto const cr = YK_JSON20_WIDEN_STRING(charT, "\r");
-      auto const tab = YK_JSON20_WIDEN_STRING(charT, "\t");
-
-      if (sequence.starts_with(quote)) return {std::basic_string<charT>{quote}, sequence.substr(quote.size())};
-      if (sequence.starts_with(backslash)) return {std::basic_string<charT>{backslash}, sequence.substr(backslash.size())};
-      if (sequence.starts_with(slash)) return {std::basic_string<charT>{slash}, sequence.substr(slash.size())};
-      if (sequence.starts_with(str_b)) return {std::basic_string<charT>{backspace}, sequence.substr(str_b.size())};
-      if (sequence.starts_with(str_f)) return {std::basic_string<charT>{formfeed}, sequence.substr(str_f.size())};
-      if (sequence.starts_with(str_n)) return {std::basic_string<charT>{linefeed}, sequence.substr(str_n.size())};
-      if (sequence.starts_with(str_r)) return {std::basic_string<charT>{cr}, sequence.substr(str_r.size())};
-      if (sequence.starts_with(str_t)) return {std::basic_string<charT>{tab}, sequence.substr(str_t.size())};
-      return {std::nullopt, s};
-    };
+  // scans a string token; `match` is the unescaped content, which refers either into `str` (no escapes) or into `buffer`
+  static constexpr parse_result<> scan_string(std::basic_string_view<charT> str, std::basic_string<charT>& buffer)
+  {
+    constexpr auto quote = YK_JSON20_WIDEN_STRING(charT, "\"");
+    constexpr auto backslash = YK_JSON20_WIDEN_STRING(charT, "\\");
+
+    if (!str.starts_with(quote)) return {std::nullopt, str};
+
+    bool escaped = false;
+    std::size_t pos = quote.size();
+    while (true) {
+      std::size_t const special = detail::find_string_special(str, pos);
+      if (special == str.size()) return {std::nullopt, str};
+      if (escaped) buffer.append(str.substr(pos, special - pos));
+
+      auto const rest = str.substr(special);
+      if (rest.starts_with(quote)) {
+        if (escaped) return {std::basic_string_view<charT>{buffer}, rest.substr(quote.size())};
+        return {str.substr(quote.size(), special - quote.size()), rest.substr(quote.size())};
+      }
+      if (!rest.starts_with(backslash)) return {std::nullopt, str};  // control character
 
-    auto const str_parser = [&](std::basic_string_view<charT> s) -> parse_result<std::basic_string<charT>> {
-      auto const res = many(alt(except(alt(lit(quote), lit(backslash), cntrl)), escape_sequence))(s);
-      if (!res.match) return {std::nullopt, s};
-      std::basic_string<charT> result;
-      for (auto& var : *res.match) {
-        std::visit([&](auto&& str_like) { result.append(std::move(str_like)); }, std::move(var));
+      if (!escaped) {
+        buffer.assign(str.substr(quote.size(), special - quote.size()));
+        escaped = true;
       }
-      return {result, res.rest};
+      auto const consumed = unescape(rest, buffer);
+      if (consumed == 0) return {std::nullopt, str};
+      pos = special + consumed;
+    }
+  }
+
+  // decodes one escape sequence at the beginning of `str` into `buffer`; returns the number of code units consumed, or 0 if ill-formed
+  static constexpr std::size_t unescape(std::basic_string_view<charT> str, std::basic_string<charT>& buffer)
+  {
+    if (str.size() < 2) return 0;
+    switch (detail::to_code_unit(str[1])) {
+      case U'"': buffer.push_back(str[1]); return 2;
+      case U'\\': buffer.push_back(str[1]); return 2;
+      case U'/': buffer.push_back(str[1]); return 2;
+      case U'b': buffer.push_back(YK_JSON20_WIDEN_STRING(charT, "\b").data[0]); return 2;
+      case U'f': buffer.push_back(YK_JSON20_WIDEN_STRING(charT, "\f").data[0]); return 2;
+      case U'n': buffer.push_back(YK_JSON20_WIDEN_STRING(charT, "\n").data[0]); return 2;
+      case U'r': buffer.push_back(YK_JSON20_WIDEN_STRING(charT, "\r").data[0]); return 2;
+      case U't': buffer.push_back(YK_JSON20_WIDEN_STRING(charT, "\t").data[0]); return 2;
+      case U'u': break;
+      default: return 0;
+    }
+
+    auto const hex4 = [](std::basic_string_view<charT> s) -> std::optional<char32_t> {
+      if (s.size() < 4) return std::nullopt;
+      char32_t value = 0;
+      for (std::size_t i = 0; i < 4; ++i) {
+        int const digit = detail::hex_digit_value(s[i]);
+        if (digit < 0) return std::nullopt;
+        value = value * 16 + static_cast<char32_t>(digit);
+      }
+      return value;
     };
 
-    auto const parser = seq(lit(quote), str_parser, lit(quote));
+    auto const high = hex4(str.substr(2));
+    if (!high) return 0;
+    if (*high < 0xD800 || *high > 0xDFFF) {
+      detail::append_code_point(buffer, *high);
+      return 6;
+    }
+    if (*high > 0xDBFF) return 0;  // unpaired low surrogate
 
-    auto res = parser(str);
+    auto const trail = str.substr(6);
+    if (trail.size() < 2 || detail::to_code_unit(trail[0]) != U'\\' || detail::to_code_unit(trail[1]) != U'u') return 0;
+    auto const low = hex4(trail.substr(2));
+    if (!low || *low < 0xDC00 || *low > 0xDFFF) return 0;
+    detail::append_code_point(buffer, 0x10000 + ((*high - 0xD800) << 10) + (*low - 0xDC00));
+    return 12;
+  }
+
+  template<class Context>
+  static constexpr parse_result<> parse_string(Context& ctx, std::basic_string_view<charT> str) noexcept
+  {
+    ctx.buffer.clear();
+    auto res = scan_string(str, ctx.buffer);
     if (res.match) {
       std::basic_string_view<charT> match{str.begin(), res.rest.begin()};
-      auto const content = std::get<0>(std::get<1>(*res.match));
-      YK_JSON20_INVOKE_VISITOR(vis, on_string, content, match)
+      auto const content = *res.match;
+      if (YK_JSON20_INVOKE_VISITOR(ctx.vis, on_string, content, match) == visit_action::stop) return halt(ctx, str);
       return {match, res.rest};
     }
     return {std::nullopt, str};
   }
 
-  template<class Visitor>
-  static constexpr parse_result<> parse_object(Visitor& vis, std::basic_string_view<charT> str) noexcept
+  template<class Context>
+  static constexpr parse_result<> parse_key(Context& ctx, std::basic_string_view<charT> str) noexcept
+  {
+    if (ctx.stopped) return {std::nullopt, str};
+    if constexpr (!has_on_key<decltype(ctx.vis)>) {
+      return parse_string(ctx, str);
+    } else {
+      ctx.buffer.clear();
+      auto res = scan_string(str, ctx.buffer);
+      if (res.match) {
+        std::basic_string_view<charT> match{str.begin(), res.rest.begin()};
+        auto const content = *res.match;
+        switch (YK_JSON20_INVOKE_VISITOR(ctx.vis, on_key, content, match)) {
+          case visit_action::proceed: break;
+          case visit_action::skip: ctx.skip_value = true; break;
+          case visit_action::stop: return halt(ctx, str);
+        }
+        return {match, res.rest};
+      }
+      return {std::nullopt, str};
+    }
+  }
+
+  // jumps over the array or object at the beginning of `str` by matching brackets outside of strings;
+  // the skipped text is only checked for balanced brackets and terminated strings
+  static constexpr parse_result<> skip_container(std::basic_string_view<charT> str) noexcept
+  {
+    std::size_t depth = 0;
+    for (std::size_t i = 0; i < str.size(); ++i) {
+      switch (detail::to_code_unit(str[i])) {
+        case U'[':
+        case U'{': ++depth; break;
+        case U']':
+        case U'}':
+          if (--depth == 0) return {str.substr(0, i + 1), str.substr(i + 1)};
+          break;
+        case U'"':
+          for (++i;; ++i) {
+            i = detail::find_string_special(str, i);
+            if (i == str.size()) return {std::nullopt, str};
+            char32_t const c = detail::to_code_unit(str[i]);
+            if (c == U'"') break;
+            if (c != U'\\') return {std::nullopt, str};  // control character
+            ++i;
+          }
+          break;
+        default: break;
+      }
+    }
+    return {std::nullopt, str};
+  }
+
+  // consumes a member value without reporting it
+  template<class Context>
+  static constexpr parse_result<> skip_value(Context& ctx, std::basic_string_view<charT> str) noexcept
+  {
+    auto const value = ws(str).rest;
+    if (value.starts_with(YK_JSON20_WIDEN_STRING(charT, "[")) || value.starts_with(YK_JSON20_WIDEN_STRING(charT, "{"))) {
+      auto res = skip_container(value);
+      if (!res.match) return {std::nullopt, str};
+      auto const rest = ws(res.rest).rest;
+      return {std::basic_string_view<charT>{str.begin(), rest.begin()}, rest};
+    }
+    struct silent_visitor {} silent;
+    parse_context<silent_visitor> silent_ctx{silent, ctx.buffer};
+    return parse_value(silent_ctx, str);
+  }
+
+  template<class Context>
+  static constexpr parse_result<> parse_object(Context& ctx, std::basic_string_view<charT> str) noexcept
   {
     auto const open_brace = YK_JSON20_WIDEN_STRING(charT, "{");
     auto const close_brace = YK_JSON20_WIDEN_STRING(charT, "}");
@@ -988,35 +2526,47 @@ private:
     auto const comma = YK_JSON20_WIDEN_STRING(charT, ",");
 
     auto const key_value_parser =
-        seq(ws, std::bind_front(parse_string<Visitor>, std::ref(vis)), ws, lit(colon), std::bind_front(parse_value<Visitor>, std::ref(vis)));
+        seq(ws, std::bind_front(parse_key<Context>, std::ref(ctx)), ws, lit(colon), std::bind_front(parse_value<Context>, std::ref(ctx)));
     auto const parser = seq(lit(open_brace), alt(sep_by(key_value_parser, lit(comma)), ws), lit(close_brace));
 
-    YK_JSON20_INVOKE_VISITOR(vis, on_object_start)
+    if (!str.starts_with(open_brace)) return {std::nullopt, str};
+
+    switch (YK_JSON20_INVOKE_VISITOR(ctx.vis, on_object_start)) {
+      case visit_action::proceed: break;
+      case visit_action::skip: return skip_container(str);
+      case visit_action::stop: return halt(ctx, str);
+    }
     auto res = parser(str);
     if (res.match) {
       std::basic_string_view<charT> match{str.begin(), res.rest.begin()};
-      YK_JSON20_INVOKE_VISITOR(vis, on_object_finalize, match)
+      if (YK_JSON20_INVOKE_VISITOR(ctx.vis, on_object_finalize, match) == visit_action::stop) return halt(ctx, str);
       return {match, res.rest};
     }
-    YK_JSON20_INVOKE_VISITOR(vis, on_object_abort)
+    ctx.skip_value = false;
+    if (!ctx.stopped) YK_JSON20_INVOKE_VISITOR(ctx.vis, on_object_abort);
     return {std::nullopt, str};
   }
 
-  template<class Visitor>
-  static constexpr parse_result<> parse_value(Visitor& vis, std::basic_string_view<charT> str) noexcept
+  template<class Context>
+  static constexpr parse_result<> parse_value(Context& ctx, std::basic_string_view<charT> str) noexcept
   {
     auto const parser =
         seq(ws,
             alt(
-                std::bind_front(parse_null<Visitor>, std::ref(vis)),     //
-                std::bind_front(parse_boolean<Visitor>, std::ref(vis)),  //
-                std::bind_front(parse_number<Visitor>, std::ref(vis)),   //
-                std::bind_front(parse_string<Visitor>, std::ref(vis)),   //
-                std::bind_front(parse_array<Visitor>, std::ref(vis)),    //
-                std::bind_front(parse_object<Visitor>, std::ref(vis))    //
+                std::bind_front(parse_null<Context>, std::ref(ctx)),     //
+                std::bind_front(parse_boolean<Context>, std::ref(ctx)),  //
+                std::bind_front(parse_number<Context>, std::ref(ctx)),   //
+                std::bind_front(parse_string<Context>, std::ref(ctx)),   //
+                std::bind_front(parse_array<Context>, std::ref(ctx)),    //
+                std::bind_front(parse_object<Context>, std::ref(ctx))    //
             ),
             ws);
 
+    if (ctx.stopped) return {std::nullopt, str};
+    if (ctx.skip_value) {
+      ctx.skip_value = false;
+      return skip_value(ctx, str);
+    }
     auto res = parser(str);
     if (res.match) {
       return {std::basic_string_view<charT>{str.begin(), res.rest.begin()}, res.rest};
@@ -1024,34 +2574,114 @@ private:
     return {std::nullopt, str};
   }
 
+  // a parse the visitor stopped counts as a success that consumed the whole input
+  template<class Context>
+  static constexpr parse_result<> parse_document(Context& ctx, std::basic_string_view<charT> str) noexcept
+  {
+    auto res = parse_value(ctx, str);
+    if (ctx.stopped) return {str, str.substr(str.size())};
+    return res;
+  }
+
+  // the input must be well-formed in the Unicode encoding form of charT before any token is examined
+  template<class Visitor>
+  static constexpr parse_result<> parse_text(Visitor& vis, std::basic_string_view<charT> str, std::basic_string<charT>& buffer) noexcept
+  {
+    if (!detail::validate_encoding(str)) return {std::nullopt, str};
+    parse_context<Visitor> ctx{vis, buffer};
+    return parse_document(ctx, str);
+  }
+
+  template<class Visitor>
+  static constexpr parse_result<> parse_text(Visitor& vis, std::basic_string_view<charT> str) noexcept
+  {
+    std::basic_string<charT> buffer;
+    return parse_text(vis, str, buffer);
+  }
+
 public:
   static constexpr basic_json<charT> parse(std::basic_string_view<charT> str)
   {
     basic_json_visitor<charT> vis;
-    if (auto res = parse_value(vis, str)) return vis.get();
+    if (auto res = parse_text(vis, str)) return std::move(vis).get();
     throw std::invalid_argument("invalid JSON");
   }
 
   static constexpr std::optional<basic_json<charT>> try_parse(std::basic_string_view<charT> str) noexcept
   {
     basic_json_visitor<charT> vis;
-    if (auto res = parse_value(vis, str)) return vis.get();
+    if (auto res = parse_text(vis, str)) return std::move(vis).get();
+    return std::nullopt;
+  }
+
+  // parses `str` and builds the document in another character type, transcoding each token once while visiting
+  template<class toCharT>
+  static constexpr basic_json<toCharT> parse_as(std::basic_string_view<charT> str)
+  {
+    basic_json_visitor<toCharT> vis;
+    if (auto res = parse_text(vis, str)) return std::move(vis).get();
+    throw std::invalid_argument("invalid JSON");
+  }
+
+  template<class toCharT>
+  static constexpr std::optional<basic_json<toCharT>> try_parse_as(std::basic_string_view<charT> str) noexcept
+  {
+    basic_json_visitor<toCharT> vis;
+    if (auto res = parse_text(vis, str)) return std::move(vis).get();
     return std::nullopt;
   }
 
   template<class Visitor>
   static constexpr void parse(Visitor& vis, std::basic_string_view<charT> str)
   {
-    if (auto res = parse_value(vis, str)) return;
+    if (auto res = parse_text(vis, str)) return;
     throw std::invalid_argument("invalid JSON");
   }
 
   template<class Visitor>
   static constexpr bool try_parse(Visitor& vis, std::basic_string_view<charT> str) noexcept
   {
-    if (auto res = parse_value(vis, str)) return true;
+    if (auto res = parse_text(vis, str)) return true;
     return false;
   }
+
+  static constexpr basic_json<charT> parse(std::basic_string_view<charT> str, parse_stats& stats)
+  {
+    if (auto json = try_parse(str, stats)) return *std::move(json);
+    throw std::invalid_argument("invalid JSON");
+  }
+
+  static constexpr std::optional<basic_json<charT>> try_parse(std::basic_string_view<charT> str, parse_stats& stats) noexcept
+  {
+    basic_json_visitor<charT, parse_stats> vis(stats);
+    if (!try_parse(vis, str, stats)) return std::nullopt;
+    detail::phase_timer timer(stats.build_time);
+    return std::move(vis).get();
+  }
+
+  template<class Visitor>
+  static constexpr void parse(Visitor& vis, std::basic_string_view<charT> str, parse_stats& stats)
+  {
+    if (try_parse(vis, str, stats)) return;
+    throw std::invalid_argument("invalid JSON");
+  }
+
+  template<class Visitor>
+  static constexpr bool try_parse(Visitor& vis, std::basic_string_view<charT> str, parse_stats& stats) noexcept
+  {
+    {
+      detail::phase_timer timer(stats.validate_time);
+      if (!detail::validate_encoding(str)) return false;
+    }
+    detail::phase_timer timer(stats.parse_time);
+    stats_visitor<Visitor> counting{vis, stats};
+    std::basic_string<charT> buffer;
+    parse_context<stats_visitor<Visitor>> ctx{counting, buffer};
+    auto res = parse_document(ctx, str);
+    if (!res) return false;
+    stats.bytes_consumed += str.size();
+    return true;
+  }
 };
 
 using json_parser = basic_json_parser<char>;
@@ -1060,6 +2690,68 @@ using u8json_parser = basic_json_parser<char8_t>;
 using u16json_parser = basic_json_parser<char16_t>;
 using u32json_parser = basic_json_parser<char32_t>;
 
+// a parser object that keeps its DOM builder stack and string unescape buffer between calls, so that parsing
+// many small documents on a long-lived thread does not re-grow them every time
+template<class charT>
+class basic_reusable_json_parser {
+public:
+  constexpr basic_json<charT> parse(std::basic_string_view<charT> str)
+  {
+    if (auto json = try_parse(str)) return *std::move(json);
+    throw std::invalid_argument("invalid JSON");
+  }
+
+  constexpr std::optional<basic_json<charT>> try_parse(std::basic_string_view<charT> str) noexcept
+  {
+    reset();
+    if (!basic_json_parser<charT>::parse_text(visitor_, str, buffer_)) return std::nullopt;
+    auto json = std::move(visitor_).get();
+    visitor_.clear();
+    return json;
+  }
+
+  template<class Visitor>
+  constexpr void parse(Visitor& vis, std::basic_string_view<charT> str)
+  {
+    if (try_parse(vis, str)) return;
+    throw std::invalid_argument("invalid JSON");
+  }
+
+  template<class Visitor>
+  constexpr bool try_parse(Visitor& vis, std::basic_string_view<charT> str) noexcept
+  {
+    return bool(basic_json_parser<charT>::parse_text(vis, str, buffer_));
+  }
+
+  // discards the state left behind by a failed parse; retained capacity is kept
+  constexpr void reset() noexcept
+  {
+    visitor_.clear();
+    buffer_.clear();
+  }
+
+  // releases the retained capacity
+  constexpr void shrink_to_fit()
+  {
+    reset();
+    visitor_.shrink_to_fit();
+    buffer_.shrink_to_fit();
+  }
+
+  constexpr std::size_t stack_capacity() const noexcept { return visitor_.capacity(); }
+  constexpr std::size_t buffer_capacity() const noexcept { return buffer_.capacity(); }
+
+private:
+  basic_json_visitor<charT> visitor_;
+  std::basic_string<charT> buffer_;
+};
+
+using reusable_json_parser = basic_reusable_json_parser<char>;
+using wreusable_json_parser = basic_reusable_json_parser<wchar_t>;
+using u8reusable_json_parser = basic_reusable_json_parser<char8_t>;
+using u16reusable_json_parser = basic_reusable_json_parser<char16_t>;
+using u32reusable_json_parser = basic_reusable_json_parser<char32_t>;
+
 template<class charT>
 struct basic_noop_visitor {
   constexpr void on_null(std::basic_string_view<charT>) noexcept {}
@@ -1105,4 +2797,9 @@ using u32checked_string = basic_checked_string<char32_t>;
 
 }  // namespace yk
 
+template<class charT>
+struct std::hash<yk::json20::basic_json<charT>> {
+  std::size_t operator()(yk::json20::basic_json<charT> const& json) const noexcept { return json.hash(); }
+};
+
 #endif  // YK_JSON20_HPP
@@ -0,0 +1,377 @@
+#ifndef YK_JSON20_BINARY_HPP
+#define YK_JSON20_BINARY_HPP
+
+#include <yk/json20.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace yk {
+
+namespace json20 {
+
+// snapshot image layout; every integer is a native-endian std::uint64_t and every node starts 8-byte aligned.
+// offsets are relative to the start of the image, so it can be mapped at any address.
+//
+//   header:  magic, byte-order mark, sizeof(charT), image size, root offset
+//   scalar:  kind, length, code units          (null, booleans and numbers keep their JSON text)
+//   array:   kind, count, count child offsets
+//   object:  kind, count, count {key offset, key length, value offset} sorted by key, then the key code units
+//
+// children are written before their parent, so every child offset is smaller than its parent's; the reader
+// relies on this to reject cyclic images
+namespace detail {
+
+inline constexpr std::uint64_t snapshot_magic = 0x3130'324E'4F53'4A4B;  // "KJSON201" read little-endian
+inline constexpr std::uint64_t snapshot_byte_order = 0x0102'0304'0506'0708;
+inline constexpr std::size_t snapshot_header_words = 5;
+
+template<class charT>
+class snapshot_builder {
+public:
+  std::vector<std::byte> build(basic_json<charT> const& json)
+  {
+    image_.assign(snapshot_header_words * sizeof(std::uint64_t), std::byte{});
+    std::uint64_t const root = write(json);
+    std::uint64_t const header[snapshot_header_words] = {snapshot_magic, snapshot_byte_order, sizeof(charT), image_.size(), root};
+    std::memcpy(image_.data(), header, sizeof(header));
+    return std::move(image_);
+  }
+
+private:
+  std::uint64_t write(basic_json<charT> const& json)
+  {
+    switch (json.get_kind()) {
+      case json_value_kind::array: {
+        auto const& vec = json.as_array_unchecked();
+        std::vector<std::uint64_t> children;
+        children.reserve(vec.size());
+        for (auto const& element : vec) children.push_back(write(element));
+        std::uint64_t const node = put_words({static_cast<std::uint64_t>(json_value_kind::array), vec.size()});
+        put_words(children);
+        return node;
+      }
+      case json_value_kind::object: {
+        auto const& vec = json.as_object_unchecked();
+        std::vector<std::uint64_t> values;
+        values.reserve(vec.size());
+        for (auto const& member : vec) values.push_back(write(member.second));
+        std::uint64_t const node = put_words({static_cast<std::uint64_t>(json_value_kind::object), vec.size()});
+        std::uint64_t key_offset = image_.size() + vec.size() * 3 * sizeof(std::uint64_t);
+        for (std::size_t i = 0; i < vec.size(); ++i) {
+          put_words({key_offset, vec[i].first.size(), values[i]});
+          key_offset += vec[i].first.size() * sizeof(charT);
+        }
+        for (auto const& member : vec) put_units(member.first);
+        align();
+        return node;
+      }
+      default: {
+        auto const& text = json.as_string_unchecked();
+        std::uint64_t const node = put_words({static_cast<std::uint64_t>(json.get_kind()), text.size()});
+        put_units(text);
+        align();
+        return node;
+      }
+    }
+  }
+
+  std::uint64_t put_words(std::span<std::uint64_t const> words)
+  {
+    std::uint64_t const offset = image_.size();
+    image_.resize(image_.size() + words.size_bytes());
+    std::memcpy(image_.data() + offset, words.data(), words.size_bytes());
+    return offset;
+  }
+
+  std::uint64_t put_words(std::initializer_list<std::uint64_t> words) { return put_words(std::span(words.begin(), words.size())); }
+
+  void put_units(std::basic_string_view<charT> str)
+  {
+    auto const offset = image_.size();
+    image_.resize(image_.size() + str.size() * sizeof(charT));
+    std::memcpy(image_.data() + offset, str.data(), str.size() * sizeof(charT));
+  }
+
+  void align() { image_.resize((image_.size() + 7) & ~std::size_t{7}); }
+
+  std::vector<std::byte> image_;
+};
+
+}  // namespace detail
+
+// serializes `json` into a position-independent snapshot image
+template<class charT>
+std::vector<std::byte> write_snapshot(basic_json<charT> const& json)
+{
+  return detail::snapshot_builder<charT>{}.build(json);
+}
+
+// a read-only handle to one value inside a snapshot image; it does not own the image.
+// offsets read from the image are bounds-checked, and a malformed image results in std::out_of_range
+template<class charT>
+class basic_json_snapshot_view {
+public:
+  json_value_kind get_kind() const
+  {
+    auto const kind = word(0);
+    if (kind > static_cast<std::uint64_t>(json_value_kind::object)) throw std::out_of_range{"corrupt snapshot"};
+    return static_cast<json_value_kind>(kind);
+  }
+
+  bool as_boolean() const { return std::make_from_tuple<bool>(deserializer<bool, charT>::deserialize(text(json_value_kind::boolean)).args); }
+
+  template<class T = std::uint64_t>
+  T as_unsigned_integer() const
+  {
+    return std::make_from_tuple<T>(deserializer<T, charT>::deserialize(text(json_value_kind::number_unsigned_integer)).args);
+  }
+
+  template<class T = std::int64_t>
+  T as_signed_integer() const
+  {
+    return std::make_from_tuple<T>(deserializer<T, charT>::deserialize(text(json_value_kind::number_signed_integer)).args);
+  }
+
+  template<class T = double>
+  T as_floating_point() const
+  {
+    return std::make_from_tuple<T>(deserializer<T, charT>::deserialize(text(json_value_kind::number_floating_point)).args);
+  }
+
+  // refers into the image
+  std::basic_string_view<charT> as_string() const { return text(json_value_kind::string); }
+
+  // number of elements or members
+  std::size_t size() const
+  {
+    auto const kind = get_kind();
+    if (kind != json_value_kind::array && kind != json_value_kind::object) throw bad_json_access{};
+    return static_cast<std::size_t>(word(1));
+  }
+
+  basic_json_snapshot_view at(std::size_t index) const
+  {
+    if (get_kind() != json_value_kind::array) throw bad_json_access{};
+    if (index >= word(1)) throw std::out_of_range{"snapshot array index out of range"};
+    return child(word(2 + index));
+  }
+
+  basic_json_snapshot_view at(std::basic_string_view<charT> key) const
+  {
+    if (auto value = find(key)) return *value;
+    throw std::out_of_range{"json has not such key"};
+  }
+
+  // binary search over the sorted key table
+  std::optional<basic_json_snapshot_view> find(std::basic_string_view<charT> key) const
+  {
+    if (get_kind() != json_value_kind::object) throw bad_json_access{};
+    std::uint64_t lo = 0;
+    std::uint64_t hi = word(1);
+    while (lo < hi) {
+      std::uint64_t const mid = lo + (hi - lo) / 2;
+      auto const cmp = key_at(mid).compare(key);
+      if (cmp == 0) return child(word(2 + mid * 3 + 2));
+      if (cmp < 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::basic_string_view<charT> key_at(std::size_t index) const
+  {
+    if (get_kind() != json_value_kind::object) throw bad_json_access{};
+    if (index >= word(1)) throw std::out_of_range{"snapshot member index out of range"};
+    return units(word(2 + index * 3), word(2 + index * 3 + 1));
+  }
+
+  basic_json_snapshot_view value_at(std::size_t index) const
+  {
+    if (get_kind() != json_value_kind::object) throw bad_json_access{};
+    if (index >= word(1)) throw std::out_of_range{"snapshot member index out of range"};
+    return child(word(2 + index * 3 + 2));
+  }
+
+  // copies the subtree into a basic_json
+  basic_json<charT> to_json() const
+  {
+    switch (get_kind()) {
+      case json_value_kind::array: {
+        auto json = basic_json<charT>::array({});
+        for (std::size_t i = size(); i-- > 0;) json[i] = at(i).to_json();
+        return json;
+      }
+      case json_value_kind::object: {
+        basic_json<charT> json;
+        for (std::size_t i = 0; i < size(); ++i) json.emplace(key_at(i), value_at(i).to_json());
+        return json;
+      }
+      case json_value_kind::null: return basic_json<charT>(nullptr);
+      case json_value_kind::boolean: return basic_json<charT>(as_boolean());
+      case json_value_kind::string: return basic_json<charT>(as_string());
+      default: {
+        // numbers keep their original text
+        basic_json_visitor<charT> vis;
+        auto const str = units(offset_ + 2 * sizeof(std::uint64_t), word(1));
+        if (get_kind() == json_value_kind::number_floating_point) {
+          vis.on_number_floating_point(str);
+        } else if (get_kind() == json_value_kind::number_signed_integer) {
+          vis.on_number_signed_integer(str);
+        } else {
+          vis.on_number_unsigned_integer(str);
+        }
+        return std::move(vis).get();
+      }
+    }
+  }
+
+private:
+  template<class charT2>
+  friend class basic_json_snapshot;
+
+  basic_json_snapshot_view(std::span<std::byte const> image, std::uint64_t offset) noexcept : image_(image), offset_(offset) {}
+
+  std::uint64_t word(std::uint64_t index) const
+  {
+    std::uint64_t const pos = offset_ + index * sizeof(std::uint64_t);
+    if (pos + sizeof(std::uint64_t) > image_.size() || pos < offset_) throw std::out_of_range{"corrupt snapshot"};
+    std::uint64_t value;
+    std::memcpy(&value, image_.data() + pos, sizeof(value));
+    return value;
+  }
+
+  basic_json_snapshot_view child(std::uint64_t offset) const
+  {
+    if (offset >= offset_ || offset % alignof(std::uint64_t) != 0) throw std::out_of_range{"corrupt snapshot"};
+    return {image_, offset};
+  }
+
+  std::basic_string_view<charT> units(std::uint64_t offset, std::uint64_t length) const
+  {
+    if (offset > image_.size() || length > (image_.size() - offset) / sizeof(charT) || offset % alignof(charT) != 0) {
+      throw std::out_of_range{"corrupt snapshot"};
+    }
+    return {reinterpret_cast<charT const*>(image_.data() + offset), static_cast<std::size_t>(length)};
+  }
+
+  std::basic_string_view<charT> text(json_value_kind kind) const
+  {
+    if (get_kind() != kind) throw bad_json_access{};
+    return units(offset_ + 2 * sizeof(std::uint64_t), word(1));
+  }
+
+  std::span<std::byte const> image_;
+  std::uint64_t offset_;
+};
+
+// validates the header of a snapshot image and gives access to its root value
+template<class charT>
+class basic_json_snapshot {
+public:
+  static basic_json_snapshot open(std::span<std::byte const> image)
+  {
+    if (auto snapshot = try_open(image)) return *snapshot;
+    throw std::invalid_argument("invalid snapshot");
+  }
+
+  static std::optional<basic_json_snapshot> try_open(std::span<std::byte const> image) noexcept
+  {
+    std::uint64_t header[detail::snapshot_header_words];
+    if (image.size() < sizeof(header) || reinterpret_cast<std::uintptr_t>(image.data()) % alignof(std::uint64_t) != 0) return std::nullopt;
+    std::memcpy(header, image.data(), sizeof(header));
+    if (header[0] != detail::snapshot_magic || header[1] != detail::snapshot_byte_order || header[2] != sizeof(charT)) return std::nullopt;
+    if (header[3] != image.size() || header[4] < sizeof(header) || header[4] >= image.size()) return std::nullopt;
+    return basic_json_snapshot(image, header[4]);
+  }
+
+  basic_json_snapshot_view<charT> root() const noexcept { return {image_, root_}; }
+
+private:
+  basic_json_snapshot(std::span<std::byte const> image, std::uint64_t root) noexcept : image_(image), root_(root) {}
+
+  std::span<std::byte const> image_;
+  std::uint64_t root_;
+};
+
+using json_snapshot = basic_json_snapshot<char>;
+using json_snapshot_view = basic_json_snapshot_view<char>;
+
+// a read-only, shared mapping of a whole file; pages are shared between every process mapping the same file
+class mapped_file {
+public:
+  explicit mapped_file(char const* path)
+  {
+    int const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "open");
+    struct ::stat st;
+    if (::fstat(fd, &st) != 0) {
+      int const error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "fstat");
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ != 0) {
+      void* const addr = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+      if (addr == MAP_FAILED) {
+        int const error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "mmap");
+      }
+      data_ = static_cast<std::byte const*>(addr);
+    }
+    ::close(fd);
+  }
+
+  mapped_file(mapped_file&& other) noexcept : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+  mapped_file& operator=(mapped_file&& other) noexcept
+  {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~mapped_file() { unmap(); }
+
+  std::span<std::byte const> bytes() const noexcept { return {data_, size_}; }
+
+private:
+  void unmap() noexcept
+  {
+    if (data_) ::munmap(const_cast<std::byte*>(data_), size_);
+  }
+
+  std::byte const* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace json20
+
+}  // namespace yk
+
+#endif  // YK_JSON20_BINARY_HPP
@@ -0,0 +1,49 @@
+#ifndef YK_JSON20_FD_SINK_HPP
+#define YK_JSON20_FD_SINK_HPP
+
+#include <yk/json20.hpp>
+
+#include <string_view>
+#include <system_error>
+
+#include <cerrno>
+
+#include <unistd.h>
+
+namespace yk {
+
+namespace json20 {
+
+// writes to a POSIX file descriptor, retrying short writes and EINTR; fails with std::system_error.
+// the descriptor is not owned
+template<class charT>
+class basic_fd_sink {
+public:
+  explicit basic_fd_sink(int fd) noexcept : fd_(fd) {}
+
+  void write(std::basic_string_view<charT> chunk)
+  {
+    auto const* data = reinterpret_cast<char const*>(chunk.data());
+    std::size_t size = chunk.size() * sizeof(charT);
+    while (size != 0) {
+      ::ssize_t const written = ::write(fd_, data, size);
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        throw std::system_error(errno, std::generic_category(), "write");
+      }
+      data += written;
+      size -= static_cast<std::size_t>(written);
+    }
+  }
+
+private:
+  int fd_;
+};
+
+using fd_sink = basic_fd_sink<char>;
+
+}  // namespace json20
+
+}  // namespace yk
+
+#endif  // YK_JSON20_FD_SINK_HPP
@@ -0,0 +1,384 @@
+#ifndef YK_JSON20_SHARED_HPP
+#define YK_JSON20_SHARED_HPP
+
+#include <yk/json20.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <cassert>
+
+namespace yk {
+
+namespace json20 {
+
+// an immutable JSON value whose subtrees are shared through reference counting. copying is O(1), and the
+// modifiers return a new version that shares everything except the nodes on the path to the change, so many
+// versions of one document cost little more than their differences. nodes are never mutated after construction,
+// which makes a value safe to read from any number of threads
+template<class charT>
+class basic_shared_json {
+public:
+  using string_type = std::basic_string<charT>;
+  using array_type = std::vector<basic_shared_json>;
+  using object_type = std::vector<std::pair<string_type, basic_shared_json>>;
+
+  // one step of a path passed to set_in: a member name or an array index
+  struct path_element {
+    path_element(std::basic_string_view<charT> key) noexcept : step(key) {}
+    path_element(charT const* key) noexcept : step(std::basic_string_view<charT>(key)) {}
+    template<std::integral I>
+    path_element(I index) noexcept : step(static_cast<std::size_t>(index))
+    {
+    }
+
+    std::variant<std::basic_string_view<charT>, std::size_t> step;
+  };
+
+  basic_shared_json() : node_(std::make_shared<node const>(json_value_kind::object, std::in_place_index<2>)) {}
+
+  // deep-copies `json` into shared nodes
+  basic_shared_json(basic_json<charT> const& json) : node_(convert(json)) {}
+
+  template<class T>
+    requires(!std::same_as<std::remove_cvref_t<T>, basic_shared_json> && !std::same_as<std::remove_cvref_t<T>, basic_json<charT>> &&
+             std::constructible_from<basic_json<charT>, T>)
+  basic_shared_json(T&& x) : basic_shared_json(basic_json<charT>(std::forward<T>(x)))
+  {
+  }
+
+  json_value_kind get_kind() const noexcept { return node_->kind; }
+
+  bool as_boolean() const
+  {
+    if (get_kind() != json_value_kind::boolean) throw bad_json_access{};
+    return std::make_from_tuple<bool>(deserializer<bool, charT>::deserialize(text()).args);
+  }
+
+  template<class T = std::uint64_t>
+  T as_unsigned_integer() const
+  {
+    if (get_kind() != json_value_kind::number_unsigned_integer) throw bad_json_access{};
+    return std::make_from_tuple<T>(deserializer<T, charT>::deserialize(text()).args);
+  }
+
+  template<class T = std::int64_t>
+  T as_signed_integer() const
+  {
+    if (get_kind() != json_value_kind::number_signed_integer) throw bad_json_access{};
+    return std::make_from_tuple<T>(deserializer<T, charT>::deserialize(text()).args);
+  }
+
+  template<class T = double>
+  T as_floating_point() const
+  {
+    if (get_kind() != json_value_kind::number_floating_point) throw bad_json_access{};
+    return std::make_from_tuple<T>(deserializer<T, charT>::deserialize(text()).args);
+  }
+
+  string_type const& as_string() const
+  {
+    if (get_kind() != json_value_kind::string) throw bad_json_access{};
+    return text();
+  }
+
+  array_type const& as_array() const
+  {
+    if (get_kind() != json_value_kind::array) throw bad_json_access{};
+    return std::get<1>(node_->data);
+  }
+
+  object_type const& as_object() const
+  {
+    if (get_kind() != json_value_kind::object) throw bad_json_access{};
+    return std::get<2>(node_->data);
+  }
+
+  // the returned references stay valid as long as this value (or any copy sharing the node) is alive
+  basic_shared_json const& at(std::size_t index) const { return as_array().at(index); }
+
+  basic_shared_json const& at(std::basic_string_view<charT> key) const
+  {
+    auto const& vec = as_object();
+    auto iter = find(vec, key);
+    if (iter == vec.end() || iter->first != key) throw std::out_of_range{"json has not such key"};
+    return iter->second;
+  }
+
+  // unlike basic_json::try_at, these do not copy the subtree
+  basic_shared_json const* find(std::size_t index) const noexcept
+  {
+    if (get_kind() != json_value_kind::array) return nullptr;
+    auto const& vec = std::get<1>(node_->data);
+    return index < vec.size() ? &vec[index] : nullptr;
+  }
+
+  basic_shared_json const* find(std::basic_string_view<charT> key) const noexcept
+  {
+    if (get_kind() != json_value_kind::object) return nullptr;
+    auto const& vec = std::get<2>(node_->data);
+    auto iter = find(vec, key);
+    return iter != vec.end() && iter->first == key ? &iter->second : nullptr;
+  }
+
+  // returns a copy of this object with `key` set to `value`
+  basic_shared_json set(std::basic_string_view<charT> key, basic_shared_json value) const
+  {
+    object_type vec = as_object();
+    auto iter = find(vec, key);
+    if (iter != vec.end() && iter->first == key) {
+      iter->second = std::move(value);
+    } else {
+      vec.emplace(iter, key, std::move(value));
+    }
+    return basic_shared_json(json_value_kind::object, std::in_place_index<2>, std::move(vec));
+  }
+
+  // returns a copy of this array with the element at `index` replaced
+  basic_shared_json set(std::size_t index, basic_shared_json value) const
+  {
+    array_type vec = as_array();
+    vec.at(index) = std::move(value);
+    return basic_shared_json(json_value_kind::array, std::in_place_index<1>, std::move(vec));
+  }
+
+  basic_shared_json push_back(basic_shared_json value) const
+  {
+    array_type vec;
+    vec.reserve(as_array().size() + 1);
+    vec = as_array();
+    vec.push_back(std::move(value));
+    return basic_shared_json(json_value_kind::array, std::in_place_index<1>, std::move(vec));
+  }
+
+  // returns a copy of this object without `key`; the node is shared if there is no such member
+  basic_shared_json erase(std::basic_string_view<charT> key) const
+  {
+    auto const& members = as_object();
+    auto iter = find(members, key);
+    if (iter == members.end() || iter->first != key) return *this;
+    object_type vec;
+    vec.reserve(members.size() - 1);
+    vec.insert(vec.end(), members.begin(), iter);
+    vec.insert(vec.end(), std::next(iter), members.end());
+    return basic_shared_json(json_value_kind::object, std::in_place_index<2>, std::move(vec));
+  }
+
+  // returns a copy of this document with the value at the nested location `path` set to `value`. each element of
+  // `path` is a member name or an array index; missing members are added, and only the nodes along the path are copied
+  basic_shared_json set_in(std::span<path_element const> path, basic_shared_json value) const
+  {
+    if (path.empty()) return value;
+    auto const rest = path.subspan(1);
+    if (auto const* key = std::get_if<0>(&path.front().step)) {
+      auto const* child = find(*key);
+      return set(*key, (child ? *child : basic_shared_json{}).set_in(rest, std::move(value)));
+    }
+    auto const index = std::get<1>(path.front().step);
+    return set(index, at(index).set_in(rest, std::move(value)));
+  }
+
+  basic_shared_json set_in(std::initializer_list<path_element> path, basic_shared_json value) const
+  {
+    return set_in(std::span(path.begin(), path.size()), std::move(value));
+  }
+
+  // true if both values refer to the same node, which implies equality
+  bool shares_storage_with(basic_shared_json const& other) const noexcept { return node_ == other.node_; }
+
+  // deep-copies the document into a mutable basic_json
+  basic_json<charT> to_json() const
+  {
+    switch (get_kind()) {
+      case json_value_kind::array: {
+        basic_json<charT> json = basic_json<charT>::array({});
+        auto const& vec = std::get<1>(node_->data);
+        for (std::size_t i = 0; i < vec.size(); ++i) json[i] = vec[i].to_json();
+        return json;
+      }
+      case json_value_kind::object: {
+        basic_json<charT> json;
+        for (auto const& [key, value] : std::get<2>(node_->data)) json.emplace(key, value.to_json());
+        return json;
+      }
+      default: {
+        basic_json_visitor<charT> vis;
+        emit(vis);
+        return std::move(vis).get();
+      }
+    }
+  }
+
+  // structural equality with the same rules as basic_json; shared subtrees are not descended into
+  friend bool operator==(basic_shared_json const& lhs, basic_shared_json const& rhs)
+  {
+    if (lhs.node_ == rhs.node_) return true;
+    auto const lhs_kind = lhs.get_kind();
+    auto const rhs_kind = rhs.get_kind();
+    if (lhs_kind == json_value_kind::array || lhs_kind == json_value_kind::object || rhs_kind == json_value_kind::array ||
+        rhs_kind == json_value_kind::object) {
+      if (lhs_kind != rhs_kind) return false;
+      if (lhs_kind == json_value_kind::array) return std::ranges::equal(std::get<1>(lhs.node_->data), std::get<1>(rhs.node_->data));
+      return std::ranges::equal(std::get<2>(lhs.node_->data), std::get<2>(rhs.node_->data));
+    }
+    return lhs.to_json() == rhs.to_json();
+  }
+
+private:
+  struct node {
+    json_value_kind kind;
+    std::variant<string_type, array_type, object_type> data;
+
+    template<class... Args>
+    node(json_value_kind kind, Args&&... args) : kind(kind), data(std::forward<Args>(args)...)
+    {
+    }
+  };
+
+  template<class charT2>
+  friend class basic_shared_json_visitor;
+
+  template<class... Args>
+  explicit basic_shared_json(json_value_kind kind, Args&&... args) : node_(std::make_shared<node const>(kind, std::forward<Args>(args)...))
+  {
+  }
+
+  string_type const& text() const noexcept { return std::get<0>(node_->data); }
+
+  template<class Members>
+  static auto find(Members& vec, std::basic_string_view<charT> key)
+  {
+    return std::ranges::lower_bound(vec, key, {}, &std::pair<string_type, basic_shared_json>::first);
+  }
+
+  static std::shared_ptr<node const> convert(basic_json<charT> const& json)
+  {
+    switch (json.get_kind()) {
+      case json_value_kind::array: {
+        array_type vec;
+        vec.reserve(json.as_array_unchecked().size());
+        for (auto const& element : json.as_array_unchecked()) vec.emplace_back(element);
+        return std::make_shared<node const>(json_value_kind::array, std::in_place_index<1>, std::move(vec));
+      }
+      case json_value_kind::object: {
+        object_type vec;
+        vec.reserve(json.as_object_unchecked().size());
+        for (auto const& [key, value] : json.as_object_unchecked()) vec.emplace_back(key, value);
+        return std::make_shared<node const>(json_value_kind::object, std::in_place_index<2>, std::move(vec));
+      }
+      default: return std::make_shared<node const>(json.get_kind(), std::in_place_index<0>, json.as_string_unchecked());
+    }
+  }
+
+  // replays a scalar as the corresponding visitor event
+  template<class Visitor>
+  void emit(Visitor& vis) const
+  {
+    std::basic_string_view<charT> const str = text();
+    switch (get_kind()) {
+      case json_value_kind::null: vis.on_null(str); break;
+      case json_value_kind::boolean: vis.on_boolean(str); break;
+      case json_value_kind::string: vis.on_string(str); break;
+      case json_value_kind::number_signed_integer: vis.on_number_signed_integer(str); break;
+      case json_value_kind::number_unsigned_integer: vis.on_number_unsigned_integer(str); break;
+      case json_value_kind::number_floating_point: vis.on_number_floating_point(str); break;
+      default: break;
+    }
+  }
+
+  std::shared_ptr<node const> node_;
+};
+
+using shared_json = basic_shared_json<char>;
+using wshared_json = basic_shared_json<wchar_t>;
+using u8shared_json = basic_shared_json<char8_t>;
+using u16shared_json = basic_shared_json<char16_t>;
+using u32shared_json = basic_shared_json<char32_t>;
+
+// builds a basic_shared_json directly from parser events, without an intermediate basic_json
+template<class charT>
+class basic_shared_json_visitor {
+public:
+  void on_null(std::basic_string_view<charT> str) { push_value(json_value_kind::null, str); }
+  void on_boolean(std::basic_string_view<charT> str) { push_value(json_value_kind::boolean, str); }
+  void on_number_unsigned_integer(std::basic_string_view<charT> str) { push_value(json_value_kind::number_unsigned_integer, str); }
+  void on_number_signed_integer(std::basic_string_view<charT> str) { push_value(json_value_kind::number_signed_integer, str); }
+  void on_number_floating_point(std::basic_string_view<charT> str) { push_value(json_value_kind::number_floating_point, str); }
+  void on_string(std::basic_string_view<charT> str) { push_value(json_value_kind::string, str); }
+
+  void on_array_start() { starts_.push_back(values_.size()); }
+  void on_array_finalize()
+  {
+    auto const first = values_.begin() + static_cast<std::ptrdiff_t>(starts_.back());
+    typename basic_shared_json<charT>::array_type vec(std::make_move_iterator(first), std::make_move_iterator(values_.end()));
+    finish(basic_shared_json<charT>(json_value_kind::array, std::in_place_index<1>, std::move(vec)));
+  }
+  void on_array_abort() { abort(); }
+
+  void on_object_start() { starts_.push_back(values_.size()); }
+  void on_object_finalize()
+  {
+    typename basic_shared_json<charT>::object_type vec;
+    vec.reserve((values_.size() - starts_.back()) / 2);
+    for (auto i = starts_.back(); i < values_.size(); i += 2) {
+      auto const& key = values_[i];
+      if (key.get_kind() != json_value_kind::string) throw bad_json_access{};
+      vec.emplace_back(key.text(), std::move(values_[i + 1]));
+    }
+    std::ranges::sort(vec, {}, &std::pair<std::basic_string<charT>, basic_shared_json<charT>>::first);
+    finish(basic_shared_json<charT>(json_value_kind::object, std::in_place_index<2>, std::move(vec)));
+  }
+  void on_object_abort() { abort(); }
+
+  basic_shared_json<charT> get() &&
+  {
+    assert(values_.size() == 1 && starts_.empty());
+    return std::move(values_.back());
+  }
+
+private:
+  void push_value(json_value_kind kind, std::basic_string_view<charT> str)
+  {
+    values_.push_back(basic_shared_json<charT>(kind, std::in_place_index<0>, str.begin(), str.end()));
+  }
+
+  void finish(basic_shared_json<charT> value)
+  {
+    values_.erase(values_.begin() + static_cast<std::ptrdiff_t>(starts_.back()), values_.end());
+    starts_.pop_back();
+    values_.push_back(std::move(value));
+  }
+
+  void abort()
+  {
+    values_.erase(values_.begin() + static_cast<std::ptrdiff_t>(starts_.back()), values_.end());
+    starts_.pop_back();
+  }
+
+  std::vector<basic_shared_json<charT>> values_;
+  std::vector<std::size_t> starts_;
+};
+
+template<class charT>
+basic_shared_json<charT> parse_shared(std::basic_string_view<charT> str)
+{
+  basic_shared_json_visitor<charT> vis;
+  basic_json_parser<charT>::parse(vis, str);
+  return std::move(vis).get();
+}
+
+inline shared_json parse_shared(std::string_view str) { return parse_shared<char>(str); }
+
+}  // namespace json20
+
+}  // namespace yk
+
+#endif  // YK_JSON20_SHARED_HPP
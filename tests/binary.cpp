@@ -0,0 +1,67 @@
+#include <yk/json20/binary.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+TEST_CASE("snapshot", "[binary]")
+{
+  auto const json = yk::json20::json_parser::parse(R"({"name":"ref","values":[1,-2,3.5,true,null],"nested":{"z":{},"a":[]},"":"empty key"})");
+  auto const image = yk::json20::write_snapshot(json);
+  CHECK(image.size() % 8 == 0);
+
+  auto const snapshot = yk::json20::json_snapshot::open(image);
+  auto const root = snapshot.root();
+  CHECK(root.get_kind() == yk::json20::json_value_kind::object);
+  CHECK(root.size() == 4);
+  CHECK(root.at("name").as_string() == "ref");
+  CHECK(root.at("").as_string() == "empty key");
+  CHECK(root.at("values").at(0).as_unsigned_integer() == 1);
+  CHECK(root.at("values").at(1).as_signed_integer() == -2);
+  CHECK(root.at("values").at(2).as_floating_point() == 3.5);
+  CHECK(root.at("values").at(3).as_boolean());
+  CHECK(root.at("values").at(4).get_kind() == yk::json20::json_value_kind::null);
+  CHECK(root.at("nested").key_at(0) == "a");
+  CHECK_FALSE(root.find("missing"));
+  CHECK_THROWS_AS(root.at("missing"), std::out_of_range);
+  CHECK_THROWS_AS(root.at("values").at(5), std::out_of_range);
+  CHECK_THROWS_AS(root.at("name").as_boolean(), yk::json20::bad_json_access);
+  CHECK(root.to_json() == json);
+}
+
+TEST_CASE("snapshot_invalid", "[binary]")
+{
+  auto image = yk::json20::write_snapshot(yk::json20::json_parser::parse("[1,2,3]"));
+  CHECK_FALSE(yk::json20::json_snapshot::try_open(std::span(image).first(image.size() - 8)));
+  CHECK_FALSE(yk::json20::basic_json_snapshot<char16_t>::try_open(image));
+
+  auto corrupt = image;
+  corrupt[corrupt.size() - 8] = std::byte{0xFF};  // last child offset of the root array
+  auto const root = yk::json20::json_snapshot::open(corrupt).root();
+  CHECK_THROWS_AS(root.at(2), std::out_of_range);
+
+  std::vector<std::byte> garbage(64, std::byte{0x42});
+  CHECK_THROWS_AS(yk::json20::json_snapshot::open(garbage), std::invalid_argument);
+}
+
+TEST_CASE("snapshot_mapped_file", "[binary]")
+{
+  auto const json = yk::json20::json_parser::parse(R"({"k":["v",1]})");
+  auto const image = yk::json20::write_snapshot(json);
+  std::string const path = "yk_json20_snapshot_test.bin";
+  {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    REQUIRE(file != nullptr);
+    std::fwrite(image.data(), 1, image.size(), file);
+    std::fclose(file);
+  }
+  {
+    yk::json20::mapped_file const mapped(path.c_str());
+    auto const root = yk::json20::json_snapshot::open(mapped.bytes()).root();
+    CHECK(root.at("k").at(0).as_string() == "v");
+    CHECK(root.to_json() == json);
+  }
+  std::remove(path.c_str());
+}
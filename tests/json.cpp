@@ -2,6 +2,8 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <unordered_set>
+
 using json = yk::json20::basic_json<char>;
 
 TEST_CASE("ctor", "[json]")
@@ -112,3 +114,40 @@ TEST_CASE("erase", "[json]")
   a.erase("foo");
   CHECK(a.at("bar").as_floating_point<double>() == 3.14);
 }
+
+TEST_CASE("equality", "[json]")
+{
+  using json_parser = yk::json20::basic_json_parser<char>;
+  CHECK(json_parser::parse("1") == json_parser::parse("1.0"));
+  CHECK(json_parser::parse("100") == json_parser::parse("1e2"));
+  CHECK(json_parser::parse("-0") == json_parser::parse("0.0"));
+  CHECK(json_parser::parse("0.5") == json_parser::parse("5e-1"));
+  CHECK(json_parser::parse("-3") == json(-3));
+  CHECK(json_parser::parse("1") != json_parser::parse("1.5"));
+  CHECK(json_parser::parse("1") != json_parser::parse("\"1\""));
+  CHECK(json_parser::parse("true") == json(true));
+  CHECK(json_parser::parse("null") == json(nullptr));
+  CHECK(json_parser::parse("null") != json());
+  CHECK(json_parser::parse("{\"b\":[1,2],\"a\":{}}") == json_parser::parse("{ \"a\" : {}, \"b\" : [ 1.0, 2e0 ] }"));
+  CHECK(json_parser::parse("{\"a\":1}") != json_parser::parse("{\"a\":1,\"b\":2}"));
+  CHECK(json_parser::parse("[1,2]") != json_parser::parse("[2,1]"));
+  CHECK(json_parser::parse("18446744073709551615") == json(18446744073709551615ull));
+  CHECK(json_parser::parse("-9223372036854775808") != json_parser::parse("9223372036854775808"));
+}
+
+TEST_CASE("hash", "[json]")
+{
+  using json_parser = yk::json20::basic_json_parser<char>;
+  std::hash<json> const hasher;
+  CHECK(hasher(json_parser::parse("1")) == hasher(json_parser::parse("1.0")));
+  CHECK(hasher(json_parser::parse("-0")) == hasher(json_parser::parse("0")));
+  CHECK(hasher(json_parser::parse("{\"b\":[1,2],\"a\":{}}")) == hasher(json_parser::parse("{\"a\":{},\"b\":[1.0,2e0]}")));
+  CHECK(hasher(json_parser::parse("[1,2]")) != hasher(json_parser::parse("[2,1]")));
+  CHECK(hasher(json_parser::parse("\"1\"")) != hasher(json_parser::parse("1")));
+
+  std::unordered_set<json> set;
+  set.insert(json_parser::parse("{\"id\":1,\"tags\":[\"a\"]}"));
+  set.insert(json_parser::parse("{\"tags\":[\"a\"],\"id\":1.0}"));
+  set.insert(json_parser::parse("{\"id\":2,\"tags\":[\"a\"]}"));
+  CHECK(set.size() == 2);
+}
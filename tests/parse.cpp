@@ -159,6 +159,64 @@ TEST_CASE("string", "[parse]")
   }
 }
 
+TEST_CASE("unicode_escape", "[parse]")
+{
+  {
+    const auto x = json_parser::parse("\"\\u0041\"");
+    REQUIRE(x.as_string() == "A");
+  }
+  {
+    const auto x = json_parser::parse("\"\\u00e9\\u20AC\"");
+    REQUIRE(x.as_string() == "\xC3\xA9\xE2\x82\xAC");
+  }
+  {
+    const auto x = json_parser::parse("\"\\ud83d\\ude00\"");
+    REQUIRE(x.as_string() == "\xF0\x9F\x98\x80");
+  }
+  {
+    const auto x = json_parser::parse("\"foo\\u0000bar\"");
+    REQUIRE(x.as_string() == std::string_view("foo\0bar", 7));
+  }
+  {
+    const auto x = yk::json20::u16json_parser::parse(u"\"\\ud83d\\ude00\\u00e9\"");
+    REQUIRE(x.as_string() == u"\U0001F600\u00E9");
+  }
+  {
+    const auto x = yk::json20::u32json_parser::parse(U"\"\\ud83d\\ude00\"");
+    REQUIRE(x.as_string() == U"\U0001F600");
+  }
+  CHECK_FALSE(json_parser::try_parse("\"\\u004\""));
+  CHECK_FALSE(json_parser::try_parse("\"\\u004g\""));
+  CHECK_FALSE(json_parser::try_parse("\"\\ud83d\""));
+  CHECK_FALSE(json_parser::try_parse("\"\\ud83d\\u0041\""));
+  CHECK_FALSE(json_parser::try_parse("\"\\ude00\""));
+  CHECK_FALSE(json_parser::try_parse("\"\\x\""));
+}
+
+TEST_CASE("unicode_validation", "[parse]")
+{
+  {
+    const auto x = json_parser::parse("\"caf\xC3\xA9 \xF0\x9F\x98\x80\"");
+    REQUIRE(x.as_string() == "caf\xC3\xA9 \xF0\x9F\x98\x80");
+  }
+  {
+    const std::string long_string = "\"" + std::string(100, 'a') + "\xE2\x82\xAC" + std::string(100, 'b') + "\\n\"";
+    const auto x = json_parser::parse(long_string);
+    REQUIRE(x.as_string() == std::string(100, 'a') + "\xE2\x82\xAC" + std::string(100, 'b') + "\n");
+  }
+  CHECK_FALSE(json_parser::try_parse("\"\xC3\""));
+  CHECK_FALSE(json_parser::try_parse("\"\xC0\xAF\""));
+  CHECK_FALSE(json_parser::try_parse("\"\xED\xA0\x80\""));
+  CHECK_FALSE(json_parser::try_parse("\"\xF4\x90\x80\x80\""));
+  CHECK_FALSE(json_parser::try_parse("\"" + std::string(40, 'a') + "\xFF\""));
+  CHECK_FALSE(json_parser::try_parse("\"\n\""));
+  CHECK_FALSE(yk::json20::u16json_parser::try_parse(u"\"\xD83D\""));
+
+  CHECK(yk::json20::is_valid_unicode(std::string_view("\xF0\x9F\x98\x80")));
+  CHECK_FALSE(yk::json20::is_valid_unicode(std::string_view("\xF0\x9F\x98")));
+  static_assert(yk::json20::is_valid_unicode(std::u8string_view(u8"\u00E9")));
+}
+
 TEST_CASE("object", "[parse]")
 {
   {
@@ -192,3 +250,69 @@ TEST_CASE("checked_string", "[parse]")
   f("{\"foo\":123}");
   f("[123,3.14]");
 }
+
+TEST_CASE("parse_stats", "[parse]")
+{
+  using yk::json20::json_value_kind;
+  {
+    yk::json20::parse_stats stats;
+    const auto x = json_parser::parse("{\"a\":[1,-2,3.5,\"a long string that does not fit in place\"],\"b\":{\"c\":null,\"d\":true}}", stats);
+    CHECK(x.at("b").at("d").as_boolean());
+    CHECK(stats.bytes_consumed == 83);
+    CHECK(stats.token_count(json_value_kind::object) == 2);
+    CHECK(stats.token_count(json_value_kind::array) == 1);
+    CHECK(stats.token_count(json_value_kind::string) == 5);
+    CHECK(stats.token_count(json_value_kind::number_unsigned_integer) == 1);
+    CHECK(stats.token_count(json_value_kind::number_signed_integer) == 1);
+    CHECK(stats.token_count(json_value_kind::number_floating_point) == 1);
+    CHECK(stats.token_count(json_value_kind::null) == 1);
+    CHECK(stats.token_count(json_value_kind::boolean) == 1);
+    CHECK(stats.max_depth == 2);
+    CHECK(stats.allocations > 0);
+    CHECK(stats.bytes_allocated > 0);
+  }
+  {
+    yk::json20::parse_stats stats;
+    CHECK_FALSE(json_parser::try_parse("[1,", stats));
+    CHECK(stats.bytes_consumed == 0);
+  }
+  {
+    yk::json20::parse_stats stats;
+    yk::json20::basic_noop_visitor<char> vis;
+    json_parser::parse(vis, "[[[]],[]]", stats);
+    json_parser::parse(vis, "[]", stats);
+    CHECK(stats.token_count(json_value_kind::array) == 5);
+    CHECK(stats.max_depth == 3);
+    CHECK(stats.allocations == 0);
+  }
+}
+
+TEST_CASE("reusable_parser", "[parse]")
+{
+  yk::json20::reusable_json_parser parser;
+  {
+    const auto x = parser.parse("[1,[2,[3,\"\\u00e9 escaped string that is long\"]]]");
+    CHECK(x.at(1).at(1).at(1).as_string() == "\xC3\xA9 escaped string that is long");
+  }
+  auto const stack_capacity = parser.stack_capacity();
+  auto const buffer_capacity = parser.buffer_capacity();
+  CHECK(stack_capacity > 0);
+  CHECK(buffer_capacity > 0);
+  {
+    const auto x = parser.parse("{\"a\":\"\\n\"}");
+    CHECK(x.at("a").as_string() == "\n");
+    CHECK(parser.stack_capacity() == stack_capacity);
+    CHECK(parser.buffer_capacity() == buffer_capacity);
+  }
+  CHECK_FALSE(parser.try_parse("[1,[2,"));
+  {
+    const auto x = parser.parse("42");
+    CHECK(x.as_unsigned_integer<unsigned>() == 42);
+  }
+  {
+    yk::json20::basic_noop_visitor<char> vis;
+    CHECK(parser.try_parse(vis, "[\"\\t\"]"));
+  }
+  parser.shrink_to_fit();
+  CHECK(parser.stack_capacity() == 0);
+}
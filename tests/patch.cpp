@@ -0,0 +1,112 @@
+#include <yk/json20.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+using json = yk::json20::basic_json<char>;
+using json_parser = yk::json20::basic_json_parser<char>;
+
+TEST_CASE("merge_patch", "[patch]")
+{
+  {
+    auto doc = json_parser::parse(R"({"a":"b","c":{"d":"e","f":"g"},"keep":[1,2]})");
+    doc.merge_patch(json_parser::parse(R"({"a":"z","c":{"f":null},"n":{"x":null,"y":1}})"));
+    CHECK(doc.at("a").as_string() == "z");
+    CHECK(doc.at("c").at("d").as_string() == "e");
+    CHECK_FALSE(doc.at("c").try_at("f"));
+    CHECK(doc.at("keep").at(1).as_unsigned_integer<int>() == 2);
+    CHECK_FALSE(doc.at("n").try_at("x"));
+    CHECK(doc.at("n").at("y").as_unsigned_integer<int>() == 1);
+    CHECK(doc.try_apply_patch(json_parser::parse(R"([{"op":"test","path":"","value":{"a":"z","c":{"d":"e"},"keep":[1,2],"n":{"y":1}}}])")));
+  }
+  {
+    auto doc = json_parser::parse(R"({"a":[1]})");
+    doc.merge_patch(json_parser::parse(R"({"a":{"b":"c"}})"));
+    CHECK(doc.at("a").at("b").as_string() == "c");
+  }
+  {
+    auto doc = json_parser::parse(R"([1,2])");
+    doc.merge_patch(json_parser::parse(R"({"a":null,"b":true})"));
+    CHECK(doc.as_object().size() == 1);
+    CHECK(doc.at("b").as_boolean());
+  }
+  {
+    auto doc = json_parser::parse(R"({"a":1})");
+    doc.merge_patch(json_parser::parse(R"("replaced")"));
+    CHECK(doc.as_string() == "replaced");
+  }
+}
+
+TEST_CASE("apply_patch", "[patch]")
+{
+  {
+    auto doc = json_parser::parse(R"({"foo":["bar","baz"],"a/b":1,"m~n":2})");
+    doc.apply_patch(json_parser::parse(R"([
+      {"op":"add","path":"/foo/1","value":"qux"},
+      {"op":"add","path":"/foo/-","value":"end"},
+      {"op":"remove","path":"/a~1b"},
+      {"op":"replace","path":"/m~0n","value":[true]},
+      {"op":"copy","from":"/foo/0","path":"/copied"},
+      {"op":"move","from":"/foo/2","path":"/moved"},
+      {"op":"test","path":"/foo","value":["bar","qux","end"]}
+    ])"));
+    CHECK(doc.at("foo").as_array().size() == 3);
+    CHECK(doc.at("foo").at(1).as_string() == "qux");
+    CHECK(doc.at("foo").at(2).as_string() == "end");
+    CHECK_FALSE(doc.try_at("a/b"));
+    CHECK(doc.at("m~n").at(0).as_boolean());
+    CHECK(doc.at("copied").as_string() == "bar");
+    CHECK(doc.at("moved").as_string() == "baz");
+  }
+  {
+    auto doc = json_parser::parse(R"({"a":1})");
+    doc.apply_patch(json_parser::parse(R"([{"op":"replace","path":"","value":[1,2]}])"));
+    CHECK(doc.as_array().size() == 2);
+  }
+}
+
+TEST_CASE("apply_patch_atomicity", "[patch]")
+{
+  auto const original = json_parser::parse(R"({"a":{"b":[1,2,3]},"c":"d","e":"f"})");
+  auto const check_unchanged = [&](json const& doc) {
+    CHECK(doc.as_object().size() == 3);
+    CHECK(doc.at("a").at("b").as_array().size() == 3);
+    CHECK(doc.at("a").at("b").at(0).as_unsigned_integer<int>() == 1);
+    CHECK(doc.at("a").at("b").at(2).as_unsigned_integer<int>() == 3);
+    CHECK(doc.at("c").as_string() == "d");
+    CHECK(doc.at("e").as_string() == "f");
+  };
+  {
+    auto doc = original;
+    CHECK_FALSE(doc.try_apply_patch(json_parser::parse(R"([
+      {"op":"remove","path":"/a/b/0"},
+      {"op":"add","path":"/a/b/-","value":4},
+      {"op":"replace","path":"/c","value":"x"},
+      {"op":"move","from":"/e","path":"/c"},
+      {"op":"move","from":"/a/b/1","path":"/z"},
+      {"op":"add","path":"/new","value":{}},
+      {"op":"copy","from":"/a","path":"/a2"},
+      {"op":"test","path":"/c","value":"nope"}
+    ])")));
+    check_unchanged(doc);
+  }
+  {
+    auto doc = original;
+    try {
+      doc.apply_patch(json_parser::parse(R"([{"op":"add","path":"/x","value":1},{"op":"remove","path":"/missing"}])"));
+      FAIL();
+    } catch (yk::json20::json_patch_error const& e) {
+      CHECK(e.operation_index() == 1);
+    }
+    check_unchanged(doc);
+  }
+  {
+    auto doc = original;
+    CHECK_FALSE(doc.try_apply_patch(json_parser::parse(R"([{"op":"move","from":"/a","path":"/a/b/0"}])")));
+    CHECK_FALSE(doc.try_apply_patch(json_parser::parse(R"([{"op":"add","path":"/a/b/01","value":0}])")));
+    CHECK_FALSE(doc.try_apply_patch(json_parser::parse(R"([{"op":"add","path":"/a/b/4","value":0}])")));
+    CHECK_FALSE(doc.try_apply_patch(json_parser::parse(R"([{"op":"add","path":"a","value":0}])")));
+    CHECK_FALSE(doc.try_apply_patch(json_parser::parse(R"([{"op":"frobnicate","path":"/a"}])")));
+    CHECK_FALSE(doc.try_apply_patch(json_parser::parse(R"({"op":"remove","path":"/a"})")));
+    check_unchanged(doc);
+  }
+}
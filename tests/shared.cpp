@@ -0,0 +1,66 @@
+#include <yk/json20/shared.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("shared_json", "[shared]")
+{
+  auto const v1 = yk::json20::parse_shared(R"({"server":{"host":"a","ports":[80,443]},"limits":{"cpu":2}})");
+  CHECK(v1.at("server").at("ports").at(1).as_unsigned_integer() == 443);
+  CHECK(v1.find("missing") == nullptr);
+
+  auto const copy = v1;
+  CHECK(copy.shares_storage_with(v1));
+
+  auto const v2 = v1.set_in({"server", "ports", 0}, 8080u);
+  CHECK(v2.at("server").at("ports").at(0).as_unsigned_integer() == 8080);
+  CHECK(v1.at("server").at("ports").at(0).as_unsigned_integer() == 80);
+  CHECK(v2.at("limits").shares_storage_with(v1.at("limits")));
+  CHECK(v2.at("server").at("host").shares_storage_with(v1.at("server").at("host")));
+  CHECK_FALSE(v2.at("server").shares_storage_with(v1.at("server")));
+
+  auto const v3 = v2.set_in({"server", "ports", 0}, 80u);
+  CHECK(v3 == v1);
+  CHECK(v3 != v2);
+
+  auto const v4 = v1.set("extra", true).erase("limits");
+  CHECK(v4.at("extra").as_boolean());
+  CHECK(v4.find("limits") == nullptr);
+  CHECK(v4.at("server").shares_storage_with(v1.at("server")));
+  CHECK(v1.erase("nope").shares_storage_with(v1));
+
+  auto const v5 = v1.set_in({"new", "nested"}, "x");
+  CHECK(v5.at("new").at("nested").as_string() == "x");
+
+  auto const arr = yk::json20::shared_json(yk::json20::json::array({1, 2})).push_back(3);
+  CHECK(arr.as_array().size() == 3);
+  CHECK_THROWS_AS(arr.set(5, 0), std::out_of_range);
+  CHECK_THROWS_AS(arr.set("k", 0), yk::json20::bad_json_access);
+}
+
+TEST_CASE("shared_json_conversion", "[shared]")
+{
+  auto const json = yk::json20::json_parser::parse(R"({"a":[1,-2,3.5,"s",null,false],"b":{}})");
+  yk::json20::shared_json const shared = json;
+  CHECK(shared.to_json() == json);
+  CHECK(yk::json20::parse_shared(R"({"b":{},"a":[1,-2,3.5,"s",null,false]})") == shared);
+}
+
+TEST_CASE("shared_json_threads", "[shared]")
+{
+  auto const snapshot = yk::json20::parse_shared(R"({"items":[1,2,3,4,5,6,7,8]})");
+  std::vector<std::thread> threads;
+  std::vector<std::uint64_t> sums(4);
+  for (std::size_t t = 0; t < sums.size(); ++t) {
+    threads.emplace_back([snapshot, &sum = sums[t], t] {
+      for (int round = 0; round < 1000; ++round) {
+        auto const local = snapshot.set_in({"items", t}, 0u);
+        for (auto const& item : local.at("items").as_array()) sum += item.as_unsigned_integer();
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (std::size_t t = 0; t < sums.size(); ++t) CHECK(sums[t] == 1000 * (36 - (t + 1)));
+}
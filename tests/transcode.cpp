@@ -0,0 +1,70 @@
+#include <yk/json20.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string_view>
+
+using json_parser = yk::json20::basic_json_parser<char>;
+
+TEST_CASE("parse_as", "[transcode]")
+{
+  {
+    const auto x = json_parser::parse_as<char16_t>("{\"caf\xC3\xA9\":[\"\xF0\x9F\x98\x80\",\"\\u00e9\",-12,3.5,true,null]}");
+    CHECK((x.get_kind() == yk::json20::json_value_kind::object));
+    auto const& arr = x.at(u"caf\u00E9");
+    CHECK(arr.at(0).as_string() == u"\U0001F600");
+    CHECK(arr.at(1).as_string() == u"\u00E9");
+    CHECK(arr.at(2).as_signed_integer<int>() == -12);
+    CHECK(arr.at(3).as_floating_point<double>() == 3.5);
+    CHECK(arr.at(4).as_boolean() == true);
+    CHECK((arr.at(5).get_kind() == yk::json20::json_value_kind::null));
+  }
+  {
+    const auto x = json_parser::parse_as<char32_t>("[\"a\xE2\x82\xAC\xF0\x9F\x98\x80\"]");
+    CHECK(x.at(0).as_string() == U"a\u20AC\U0001F600");
+  }
+  {
+    const auto x = json_parser::parse_as<wchar_t>("[\"\xE2\x82\xAC\",42]");
+    CHECK(x.at(0).as_string() == L"\u20AC");
+    CHECK(x.at(1).as_unsigned_integer<unsigned>() == 42u);
+  }
+  {
+    const auto x = yk::json20::u16json_parser::parse_as<char>(u"{\"k\":\"\U0001F600\u00E9\"}");
+    CHECK(x.at("k").as_string() == "\xF0\x9F\x98\x80\xC3\xA9");
+  }
+  {
+    const auto x = json_parser::parse_as<char8_t>("\"\xC3\xA9\"");
+    CHECK(x.as_string() == u8"\u00E9");
+  }
+  CHECK_FALSE(json_parser::try_parse_as<char16_t>("[\"\xC3\"]"));
+  CHECK_FALSE(yk::json20::u16json_parser::try_parse_as<char>(u"\"\xDC00\""));
+}
+
+TEST_CASE("wide_numbers", "[transcode]")
+{
+  {
+    yk::json20::u16json a(42u);
+    CHECK(a.as_unsigned_integer<unsigned>() == 42u);
+    CHECK(a.try_as_unsigned_integer<unsigned>() == 42u);
+  }
+  {
+    yk::json20::u32json a(-7);
+    CHECK(a.as_signed_integer<int>() == -7);
+  }
+  {
+    yk::json20::wjson a(0.1);
+    CHECK(a.as_floating_point<double>() == 0.1);
+  }
+  {
+    yk::json20::u16json a(true);
+    CHECK(a.as_boolean() == true);
+  }
+  {
+    const auto x = yk::json20::u32json_parser::parse(U"[1.25e2,-3]");
+    CHECK(x.at(0).as_floating_point<double>() == 125.0);
+    CHECK(x.at(1).as_signed_integer<long>() == -3);
+  }
+  CHECK(yk::json20::serializer<double, char16_t>::serialize(-2.5) == u"-2.5");
+  CHECK(yk::json20::serializer<double>::serialize(0.30000000000000004) == "0.30000000000000004");
+  CHECK(yk::json20::serializer<long long>::serialize(std::numeric_limits<long long>::min()) == "-9223372036854775808");
+}
@@ -0,0 +1,125 @@
+#include <yk/json20.hpp>
+#include <yk/json20/fd_sink.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+TEST_CASE("writer", "[writer]")
+{
+  {
+    yk::json20::json_writer writer;
+    writer.begin_object();
+    writer.key("name").value("json20");
+    writer.key("tags").begin_array().value(1).value(-2).value(0.5).value(true).value(nullptr).end_array();
+    writer.key("empty").begin_object().end_object();
+    writer.end_object();
+    CHECK(writer.done());
+    CHECK(writer.view() == R"({"name":"json20","tags":[1,-2,0.5,true,null],"empty":{}})");
+  }
+  {
+    yk::json20::json_writer writer;
+    writer.value("quote\" backslash\\ newline\n tab\t bell\x07 \xE3\x81\x82");
+    CHECK(writer.view() == R"("quote\" backslash\\ newline\n tab\t bell\u0007 )"
+                           "\xE3\x81\x82\"");
+  }
+  {
+    yk::json20::json_writer writer({.indent = 2});
+    writer.begin_object().key("a").begin_array().value(1).value(2).end_array().key("b").begin_array().end_array().end_object();
+    CHECK(writer.view() == "{\n  \"a\": [\n    1,\n    2\n  ],\n  \"b\": []\n}");
+  }
+  {
+    yk::json20::u16json_writer writer;
+    writer.begin_array().value(u"あ").value(42u).end_array();
+    CHECK(std::move(writer).str() == u"[\"あ\",42]");
+  }
+  {
+    constexpr auto size = [] {
+      yk::json20::json_writer writer;
+      writer.begin_array().value(true).value("x").end_array();
+      return writer.view().size();
+    }();
+    STATIC_REQUIRE(size == 10);
+  }
+  {
+    yk::json20::json_writer writer;
+    CHECK_THROWS_AS(writer.value(1.0 / 0.0), std::invalid_argument);
+  }
+}
+
+TEST_CASE("writer_visitor", "[writer]")
+{
+  constexpr std::string_view text = " { \"b\" : [ 1 , 2.5e3 , \"x\\u0041\" ] , \"a\" : { \"k\" : null } , \"c\" : false } ";
+  {
+    yk::json20::json_writer writer;
+    yk::json20::json_parser::parse(writer, text);
+    CHECK(writer.view() == R"({"b":[1,2.5e3,"xA"],"a":{"k":null},"c":false})");
+  }
+  {
+    yk::json20::json_writer writer({.indent = 1});
+    yk::json20::json_parser::parse(writer, "[[],{},[{}]]");
+    CHECK(writer.view() == "[\n [],\n {},\n [\n  {}\n ]\n]");
+  }
+  {
+    yk::json20::json_writer writer;
+    CHECK_FALSE(yk::json20::json_parser::try_parse(writer, R"({"a":[1,2})"));
+  }
+}
+
+TEST_CASE("writer_dom", "[writer]")
+{
+  auto const json = yk::json20::json_parser::parse(R"({"b":[1,"two",{"c":null}],"a":true})");
+  CHECK(yk::json20::serializer<yk::json20::json>::serialize(json) == R"({"a":true,"b":[1,"two",{"c":null}]})");
+  CHECK(yk::json20::json_parser::parse(yk::json20::serializer<yk::json20::json>::serialize(json, {.indent = 4})) == json);
+}
+
+TEST_CASE("writer_sinks", "[writer]")
+{
+  {
+    std::ostringstream os;
+    {
+      yk::json20::basic_json_writer<char, yk::json20::ostream_sink> writer(yk::json20::ostream_sink(os), {.chunk_size = 8});
+      writer.begin_array();
+      for (int i = 0; i < 100; ++i) writer.value(i);
+      writer.end_array();
+      CHECK(os.str().size() >= 8);  // earlier chunks were already handed over
+      writer.flush();
+    }
+    std::string expected = "[";
+    for (int i = 0; i < 100; ++i) expected += (i == 0 ? "" : ",") + std::to_string(i);
+    expected += "]";
+    CHECK(os.str() == expected);
+  }
+  {
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    {
+      yk::json20::basic_json_writer<char, yk::json20::file_sink> writer{yk::json20::file_sink(file)};
+      writer.begin_object().key("k").value("v").end_object();
+    }  // flushed on destruction
+    std::rewind(file);
+    char buf[32]{};
+    auto const n = std::fread(buf, 1, sizeof(buf), file);
+    CHECK(std::string_view(buf, n) == R"({"k":"v"})");
+    std::fclose(file);
+  }
+  {
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    {
+      yk::json20::basic_json_writer<char, yk::json20::fd_sink> writer{yk::json20::fd_sink(fds[1])};
+      writer.begin_array().value(1).value(2).end_array();
+      writer.flush();
+    }
+    ::close(fds[1]);
+    char buf[32]{};
+    auto const n = ::read(fds[0], buf, sizeof(buf));
+    ::close(fds[0]);
+    CHECK(std::string_view(buf, static_cast<std::size_t>(n)) == "[1,2]");
+  }
+}